@@ -0,0 +1,90 @@
+# ~~~
+# Copyright 2025 CryptoLab, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ~~~
+
+# Generates a constant-time bitsliced discrete Gaussian sampler for a fixed
+# sigma and adds it to a target:
+#
+#   alea_add_gaussian_sampler(<target> SIGMA <sigma> [TAILCUT <tailcut>]
+#                             [PRECISION <bits>] [NAME <name>])
+#
+# The sampler is exposed as alea_sample_dgauss_<name>_{int64,int32}_array and
+# declared in <alea/dgauss_<name>.h>. NAME defaults to s<sigma> with the dot in
+# sigma replaced by an underscore, TAILCUT to 12 and PRECISION to 64. Files are
+# generated under the calling directory's binary dir, so other targets can
+# generate private samplers without clashing with the library's.
+
+# Where the library's own samplers are generated, for installation
+set(ALEA_GENERATED_DIR ${CMAKE_CURRENT_BINARY_DIR}/generated)
+
+# The generator runs at build time, so a cross-compiled build needs either
+# CMAKE_CROSSCOMPILING_EMULATOR, which custom commands use to run target
+# executables, or a generator built for the host, passed in ALEA_DGAUSS_GEN.
+set(ALEA_DGAUSS_GEN
+    ""
+    CACHE FILEPATH "Prebuilt dgauss-gen to run on the build host.")
+
+if(ALEA_DGAUSS_GEN)
+  set(ALEA_DGAUSS_GEN_COMMAND ${ALEA_DGAUSS_GEN})
+else()
+  add_executable(alea-dgauss-gen ${PROJECT_SOURCE_DIR}/src/codegen/dgauss-gen.c)
+  target_link_libraries(alea-dgauss-gen PRIVATE m)
+  set(ALEA_DGAUSS_GEN_COMMAND alea-dgauss-gen)
+endif()
+
+function(alea_add_gaussian_sampler target)
+  cmake_parse_arguments(ARG "" "SIGMA;TAILCUT;PRECISION;NAME" "" ${ARGN})
+  if(NOT ARG_SIGMA)
+    message(FATAL_ERROR "alea_add_gaussian_sampler: SIGMA is required")
+  endif()
+  if(NOT ALEA_DGAUSS_GEN
+     AND CMAKE_CROSSCOMPILING
+     AND NOT CMAKE_CROSSCOMPILING_EMULATOR)
+    message(
+      FATAL_ERROR
+        "alea_add_gaussian_sampler: the generator cannot run when cross-"
+        "compiling. Set CMAKE_CROSSCOMPILING_EMULATOR, or build "
+        "src/codegen/dgauss-gen.c for the host and pass it in ALEA_DGAUSS_GEN.")
+  endif()
+  if(NOT ARG_TAILCUT)
+    set(ARG_TAILCUT 12)
+  endif()
+  if(NOT ARG_PRECISION)
+    set(ARG_PRECISION 64)
+  endif()
+
+  if(ARG_NAME)
+    set(suffix ${ARG_NAME})
+  else()
+    string(REPLACE "." "_" suffix "s${ARG_SIGMA}")
+  endif()
+  set(generated_dir ${CMAKE_CURRENT_BINARY_DIR}/generated)
+  set(source ${generated_dir}/src/dgauss_${suffix}.c)
+  set(header ${generated_dir}/include/alea/dgauss_${suffix}.h)
+
+  add_custom_command(
+    OUTPUT ${source} ${header}
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${generated_dir}/src
+            ${generated_dir}/include/alea
+    COMMAND ${ALEA_DGAUSS_GEN_COMMAND} ${ARG_SIGMA} ${ARG_TAILCUT}
+            ${ARG_PRECISION} ${suffix} ${source} ${header}
+    DEPENDS ${ALEA_DGAUSS_GEN_COMMAND}
+    COMMENT "Generating discrete Gaussian sampler for sigma = ${ARG_SIGMA}"
+    VERBATIM)
+
+  target_sources(${target} PRIVATE ${source} ${header})
+  target_include_directories(
+    ${target} PUBLIC $<BUILD_INTERFACE:${generated_dir}/include>)
+endfunction()
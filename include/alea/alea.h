@@ -104,10 +104,53 @@ typedef enum {
   ALEA_RETURN_BAD_FREE,
 } alea_return;
 
+/**
+ * @enum `alea_repr`
+ * @brief Representation of the residues written by the `alea_sample_*_rns`
+ * functions.
+ *
+ * @var `ALEA_REPR_STANDARD`
+ *      x mod q, in [0, q).
+ * @var `ALEA_REPR_MONTGOMERY`
+ *      x * 2^64 mod q, in [0, q).
+ */
+typedef enum {
+  ALEA_REPR_STANDARD,
+  ALEA_REPR_MONTGOMERY,
+} alea_repr;
+
 #ifndef ALEA_STATE_IMPLEMENTATION
 typedef void alea_state;
 #endif
 
+/**
+ * @brief Opaque sampler for uniform integers in a fixed range.
+ *
+ * Created with `alea_range_sampler_create` and released with
+ * `alea_range_sampler_free`. A sampler holds no random state and may be
+ * shared between threads and `alea_state` instances.
+ */
+typedef struct alea_range_sampler alea_range_sampler;
+
+/**
+ * @brief Opaque, precomputed table for discrete Gaussian sampling.
+ *
+ * Created with `alea_gaussian_table_create` and released with
+ * `alea_gaussian_table_free`. A table is read-only once created and may be
+ * shared between threads and `alea_state` instances.
+ */
+typedef struct alea_gaussian_table alea_gaussian_table;
+
+/**
+ * @brief Opaque sampler for large-sigma discrete Gaussians with arbitrary
+ * centers.
+ *
+ * Created with `alea_gaussian_sampler_create` and released with
+ * `alea_gaussian_sampler_free`. A sampler is read-only once created and may be
+ * shared between threads and `alea_state` instances.
+ */
+typedef struct alea_gaussian_sampler alea_gaussian_sampler;
+
 #define ALEA_SEED_SIZE_SHAKE128 32 // bytes
 #define ALEA_SEED_SIZE_SHAKE256 64 // bytes
 
@@ -172,6 +215,56 @@ ALEA_API alea_return alea_get_random_bytes(alea_state *state,
                                            uint8_t *const dst,
                                            const size_t dst_len);
 
+/**
+ * @brief XORs random bytes into the provided buffer.
+ *
+ * This function XORs `buf_len` random bytes generated by the ALEA RNG state
+ * into `buf`, e.g. to mask it with a one-time pad. The bytes are the ones
+ * `alea_get_random_bytes` would return, but whole blocks of the underlying XOF
+ * are XORed into `buf` as they are squeezed, without a scratch buffer.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param buf Pointer to the buffer to be masked in place.
+ * @param buf_len The number of bytes of `buf` to mask.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_xor_random_bytes(alea_state *state,
+                                           uint8_t *const buf,
+                                           const size_t buf_len);
+
+/**
+ * @brief Exposes the unread part of the state's output buffer.
+ *
+ * Returns a read-only pointer to the next random bytes of the stream and sets
+ * `*avail` to how many of them are readable, at least 1. A fresh block is
+ * generated first if the buffer is used up. Peeking does not advance the
+ * stream: call `alea_consume` for the bytes actually used, so that custom
+ * samplers can parse randomness in place instead of copying it out with
+ * `alea_get_random_bytes`, and stay in step with the other functions.
+ *
+ * The pointer is valid until the next call that uses `state`.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param avail Pointer to where the number of readable bytes is stored.
+ * @return A pointer to `*avail` random bytes.
+ */
+ALEA_API const uint8_t *alea_peek(alea_state *state, size_t *avail);
+
+/**
+ * @brief Advances the stream past bytes read through `alea_peek`.
+ *
+ * After peeking `avail` bytes and consuming `n` of them, the stream is in the
+ * same position as after `alea_get_random_bytes` of `n` bytes, and the same
+ * bytes were seen.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param n Number of bytes to consume, at most the `avail` of the last
+ * `alea_peek`.
+ * @return `ALEA_RETURN_OK`, or `ALEA_RETURN_BAD_GENERIC` without advancing the
+ * stream if `n` exceeds the readable bytes.
+ */
+ALEA_API alea_return alea_consume(alea_state *state, const size_t n);
+
 /**
  * @brief Generates a random 64-bit unsigned integer.
  *
@@ -194,6 +287,21 @@ ALEA_API uint64_t alea_get_random_uint64(alea_state *state);
  */
 ALEA_API uint32_t alea_get_random_uint32(alea_state *state);
 
+/**
+ * @brief Returns `nbits` random bits in the low bits of a 64-bit integer.
+ *
+ * Bits come from a reservoir kept in the state, which the samplers of this
+ * library share: a call consumes exactly `nbits` bits, and whatever is left of
+ * the reservoir is used by the next bit-level request. The reservoir is filled
+ * from the same output stream as `alea_get_random_bytes`, 64 bytes at a time,
+ * and is emptied by `alea_reseed`.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param nbits Number of bits to return, from 1 to 64.
+ * @return A random integer in [0, 2^`nbits`).
+ */
+ALEA_API uint64_t alea_get_random_bits(alea_state *state, const unsigned nbits);
+
 /**
  * @brief Generates a random 64-bit unsigned integer within a specified range.
  *
@@ -266,6 +374,38 @@ ALEA_API alea_return alea_get_random_uint32_array(alea_state *state,
                                                   uint32_t *const dst,
                                                   const size_t dst_len);
 
+/**
+ * @brief Generates an array of random doubles uniformly distributed in [0, 1).
+ *
+ * Each double is the top 53 bits of a random 64-bit word scaled by 2^-53, so
+ * every multiple of 2^-53 in [0, 1) is equally likely.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param dst Pointer to the destination array where random doubles will be
+ * stored.
+ * @param dst_len The number of random doubles to generate and store in `dst`.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_get_random_double_array(alea_state *state,
+                                                  double *const dst,
+                                                  const size_t dst_len);
+
+/**
+ * @brief Generates an array of random floats uniformly distributed in [0, 1).
+ *
+ * Each float is the top 24 bits of a random 32-bit word scaled by 2^-24, so
+ * every multiple of 2^-24 in [0, 1) is equally likely.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param dst Pointer to the destination array where random floats will be
+ * stored.
+ * @param dst_len The number of random floats to generate and store in `dst`.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_get_random_float_array(alea_state *state,
+                                                 float *const dst,
+                                                 const size_t dst_len);
+
 /**
  * @brief Fills an array with random 64-bit unsigned integers within a specified
  * range.
@@ -325,6 +465,270 @@ ALEA_API alea_return alea_get_random_uint32_array_in_range(
     alea_state *state, uint32_t *const dst, const size_t dst_len,
     const uint32_t range);
 
+/**
+ * @brief Fills an array with random 16-bit unsigned integers within a
+ * specified range.
+ *
+ * See `alea_get_random_uint32_array_in_range` for details.
+ *
+ * @param state Pointer to the `alea_state` structure used for random number
+ * generation.
+ * @param dst Pointer to the destination array where random numbers will be
+ * stored.
+ * @param dst_len Number of random numbers to generate (length of the
+ * destination array).
+ * @param range The exclusive upper bound for generated random numbers, from 2
+ * to 2^16. Each number will be in [0, range).
+ * @return An `alea_return` value indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_get_random_uint16_array_in_range(
+    alea_state *state, uint16_t *const dst, const size_t dst_len,
+    const uint32_t range);
+
+/**
+ * @brief Fills an array with random 8-bit unsigned integers within a
+ * specified range.
+ *
+ * See `alea_get_random_uint32_array_in_range` for details.
+ *
+ * @param state Pointer to the `alea_state` structure used for random number
+ * generation.
+ * @param dst Pointer to the destination array where random numbers will be
+ * stored.
+ * @param dst_len Number of random numbers to generate (length of the
+ * destination array).
+ * @param range The exclusive upper bound for generated random numbers, from 2
+ * to 2^8. Each number will be in [0, range).
+ * @return An `alea_return` value indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_get_random_uint8_array_in_range(
+    alea_state *state, uint8_t *const dst, const size_t dst_len,
+    const uint32_t range);
+
+/**
+ * @brief Creates a reusable sampler for uniform integers in [0, `range`).
+ *
+ * The sampler validates `range` and precomputes the rejection threshold once,
+ * so that `alea_range_sample` and `alea_range_sample_array` perform no
+ * division. Use it when the same range is sampled many times.
+ *
+ * @param range The upper limit of the range (exclusive). Must be at least 2.
+ * @return Pointer to the new sampler, or `NULL` if `range` is invalid or the
+ * allocation fails.
+ */
+ALEA_API alea_range_sampler *alea_range_sampler_create(const uint64_t range);
+
+/**
+ * @brief Frees a sampler created by `alea_range_sampler_create`.
+ *
+ * @param sampler Pointer to the sampler to be freed.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_range_sampler_free(alea_range_sampler *sampler);
+
+/**
+ * @brief Generates a random 64-bit unsigned integer in the range of the given
+ * sampler.
+ *
+ * The output follows the same distribution as
+ * `alea_get_random_uint64_in_range` with the sampler's range.
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param sampler Pointer to a sampler created by `alea_range_sampler_create`.
+ * @return A random 64-bit unsigned integer in the range [0, `range`).
+ */
+ALEA_API uint64_t alea_range_sample(alea_state *state,
+                                    const alea_range_sampler *sampler);
+
+/**
+ * @brief Fills an array with random 64-bit unsigned integers in the range of
+ * the given sampler.
+ *
+ * @details A reference implementation of this function would be:
+ * ```c
+ * for (size_t i = 0; i < dst_len; ++i) {
+ *     dst[i] = alea_range_sample(state, sampler);
+ * }
+ * ```
+ *
+ * @param state Pointer to the `alea_state` used for random number generation.
+ * @param sampler Pointer to a sampler created by `alea_range_sampler_create`.
+ * @param dst Pointer to the destination array where random numbers will be
+ * stored.
+ * @param dst_len Number of elements to fill in the destination array.
+ * @return An `alea_return` code indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_range_sample_array(alea_state *state,
+                                             const alea_range_sampler *sampler,
+                                             uint64_t *const dst,
+                                             const size_t dst_len);
+
+/**
+ * @brief Samples an integer uniformly from [0, M) for a multi-limb modulus M.
+ *
+ * Integers are arrays of `num_limbs` 64-bit limbs, least significant first.
+ * The top limb is drawn first, with as many bits as the top limb of M, and is
+ * redrawn right away if it exceeds it, so rejections rarely cost more than one
+ * word of output. The lower limbs are then drawn and the result is compared
+ * with M without branches; only rejected draws affect the running time.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_limbs` limbs.
+ * @param modulus Pointer to the `num_limbs` limbs of M. The top limb must not
+ * be zero.
+ * @param num_limbs Number of limbs of M, at least 1.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_uniform_mod_bigint(alea_state *state,
+                                                    uint64_t *const dst,
+                                                    const uint64_t *modulus,
+                                                    const size_t num_limbs);
+
+/**
+ * @brief Samples `dst_len` integers uniformly from [0, M) for a multi-limb
+ * modulus M.
+ *
+ * Integer i occupies limbs i * `num_limbs` to (i + 1) * `num_limbs` - 1 of
+ * `dst`. See `alea_sample_uniform_mod_bigint` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `dst_len * num_limbs` limbs.
+ * @param dst_len Number of integers to sample.
+ * @param modulus Pointer to the `num_limbs` limbs of M. The top limb must not
+ * be zero.
+ * @param num_limbs Number of limbs of M, at least 1.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_uniform_mod_bigint_array(
+    alea_state *state, uint64_t *const dst, const size_t dst_len,
+    const uint64_t *modulus, const size_t num_limbs);
+
+/**
+ * @brief Samples `dst_len` integers uniformly modulo the product Q of an RNS
+ * basis and writes their residues modulo every modulus.
+ *
+ * By the CRT, an integer uniform modulo Q has independent uniform residues,
+ * so each limb is sampled directly and Q is never formed. The layout is the
+ * one of `alea_sample_cbd_rns`. Since uniform residues stay uniform in
+ * Montgomery form, the output serves both representations.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_moduli * dst_len`
+ * residues.
+ * @param dst_len Number of integers to sample.
+ * @param moduli Array of `num_moduli` moduli, each at least 2.
+ * @param num_moduli Number of moduli, at least 1.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_uniform_rns(alea_state *state,
+                                             uint64_t *const dst,
+                                             const size_t dst_len,
+                                             const uint64_t *moduli,
+                                             const size_t num_moduli);
+
+/**
+ * @brief Shuffles an array of 32-bit integers in place.
+ *
+ * Every permutation of `arr` is equally likely. This is a Fisher-Yates
+ * shuffle that takes its swap indices in batches from the state's bit stream:
+ * up to 6 consecutive steps share one draw of bit_length(bound) + 8 bits,
+ * where bound is the product of their index ranges, so each index costs about
+ * log2(n) bits. Its memory accesses depend on the drawn indices, so it is not
+ * constant-time. Use `alea_shuffle_u32_ct` when the permutation must stay
+ * secret from an attacker who can observe timing.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param arr Pointer to the array to shuffle.
+ * @param n Number of elements in the array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_shuffle_u32(alea_state *state, uint32_t *const arr,
+                                      const size_t n);
+
+/**
+ * @brief Shuffles an array of 64-bit integers in place.
+ *
+ * See `alea_shuffle_u32` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param arr Pointer to the array to shuffle.
+ * @param n Number of elements in the array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_shuffle_u64(alea_state *state, uint64_t *const arr,
+                                      const size_t n);
+
+/**
+ * @brief Fills `perm` with a uniformly random permutation of 0, ..., n - 1.
+ *
+ * Same as filling `perm` with 0, ..., n - 1 and calling `alea_shuffle_u32`.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param perm Pointer to the destination array of `n` elements.
+ * @param n Number of elements, at most 2^32.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_random_permutation(alea_state *state,
+                                             uint32_t *const perm,
+                                             const size_t n);
+
+/**
+ * @brief Shuffles an array of 32-bit integers in place, in constant time.
+ *
+ * Every permutation of `arr` is equally likely. Each element is tagged with a
+ * random 64-bit key and the keys are sorted with a sorting network, so the
+ * memory accesses and running time do not depend on the permutation or the
+ * elements. The keys are redrawn if two collide, with probability below
+ * n^2 / 2^65. Allocates 16 bytes per element.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param arr Pointer to the array to shuffle.
+ * @param n Number of elements in the array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_shuffle_u32_ct(alea_state *state,
+                                         uint32_t *const arr, const size_t n);
+
+/**
+ * @brief Shuffles an array of 64-bit integers in place, in constant time.
+ *
+ * See `alea_shuffle_u32_ct` for details. Allocates 8 bytes per element.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param arr Pointer to the array to shuffle.
+ * @param n Number of elements in the array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_shuffle_u64_ct(alea_state *state,
+                                         uint64_t *const arr, const size_t n);
+
+/**
+ * @brief Fills `perm` with a uniformly random permutation of 0, ..., n - 1, in
+ * constant time.
+ *
+ * Same as filling `perm` with 0, ..., n - 1 and calling `alea_shuffle_u32_ct`.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param perm Pointer to the destination array of `n` elements.
+ * @param n Number of elements, at most 2^32.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_random_permutation_ct(alea_state *state,
+                                                uint32_t *const perm,
+                                                const size_t n);
+
 /**
  * @brief Fills an array with random 64-bit integers of specified Hamming
  * weight.
@@ -401,77 +805,357 @@ ALEA_API alea_return alea_sample_hwt_int8_array(alea_state *state,
                                                 const int hwt);
 
 /**
- * @brief Fills the destination array with random 64-bit integers sampled from a
- * centered binomial distribution.
- *
- * This function generates `dst_len` random 64-bit integers, each sampled from a
- * centered binomial distribution (CBD). The results are written to the array
- * pointed to by `dst`. The function uses the provided `state` for random number
- * generation.
- *
- * @details A _centered binomial distribution_ (CBD) is a binomial distribution
- * that is symmetric around its mean. Essentially, this can be understood as
- * a binomial distribution with a probability of success p = 0.5, i.e., coin
- * tosses. As the number of flips increases, the distribution approaches a
- * normal distribution.
+ * @brief Samples a vector of specified Hamming weight in sparse form.
  *
- * In this function, we sample integers from the binomial distribution Bin(2 *
- * n, 0.5), shifted to have a mean of zero, where n is `cbd_num_flips`. The
- * resulting integers will be in the range [-n, n]. For large n, the
- * distribution approaches a normal distribution with mean zero and standard
- * deviation sqrt(n/2). For example, if `cbd_num_flips` is 21, the function will
- * generate integers approximately from the normal distribution with mean 0 and
- * standard deviation 3.24.
+ * Describes the same distribution as `alea_sample_hwt_int64_array` with
+ * `dst_len` entries, but only the nonzero entries are written: their positions
+ * in ascending order to `idx`, and their values (1 or -1) to `sign`.
  *
- * Algorithmically, this can be implemented by sampling from two independent
- * binomial distributions Bin(n, 0.5) and subtracting the second sample from the
- * first.
+ * The running time depends on `hwt` alone, not on `dst_len` or the sampled
+ * positions, and grows quadratically with `hwt`. For dense vectors, use the
+ * array functions instead.
  *
  * @param state Pointer to the `alea_state` structure representing the RNG
  * state.
- * @param dst Pointer to the destination array where the sampled integers will
- * be stored.
- * @param dst_len Number of elements to generate and store in the destination
- * array.
- * @param cbd_num_flips The number of coin flips in a single instance. As
- * discussed in the details section, we sample from two such instances and
- * subtract one from the other. This effectively gives us a centered binomial
- * distribution with mean zero and a range approximately from `-cbd_num_flips`
- * to `cbd_num_flips`.
- * @return An `alea_return` code indicating success or failure of the operation.
+ * @param dst_len Length of the vector, at most 2^32.
+ * @param hwt The Hamming weight, from 1 to `dst_len`.
+ * @param idx Pointer to an array of `hwt` positions to be filled.
+ * @param sign Pointer to an array of `hwt` values to be filled.
+ * @return An `alea_return` code indicating success or failure of the
+ * operation.
  */
-ALEA_API alea_return alea_sample_cbd_int64_array(alea_state *state,
-                                                 int64_t *const dst,
-                                                 const size_t dst_len,
-                                                 const size_t cbd_num_flips);
+ALEA_API alea_return alea_sample_hwt_sparse(alea_state *state,
+                                            const size_t dst_len, const int hwt,
+                                            uint32_t *const idx,
+                                            int8_t *const sign);
 
 /**
- * @brief Fills the destination array with random 32-bit integers sampled from a
- * centered binomial distribution.
+ * @brief Returns the size in bytes of the workspace needed by the
+ * `alea_sample_hwt_*_array_workspace` functions.
  *
- * This function generates `dst_len` random 32-bit integers, each sampled from a
- * centered binomial distribution (CBD). The results are written to the array
- * pointed to by `dst`. The function uses the provided `state` for random number
- * generation.
+ * The size depends on the build configuration and may be zero, in which case
+ * the workspace functions accept `NULL`. The workspace is only used by the
+ * int32 and int8 variants: the int64 variant works in `dst` itself and always
+ * accepts `NULL`.
  *
- * @details A _centered binomial distribution_ (CBD) is a binomial distribution
- * that is symmetric around its mean. Essentially, this can be understood as
- * a binomial distribution with a probability of success p = 0.5, i.e., coin
- * tosses. As the number of flips increases, the distribution approaches a
- * normal distribution.
+ * @param dst_len The number of integers that will be sampled.
+ * @return The workspace size in bytes.
+ */
+ALEA_API size_t alea_hwt_workspace_size(const size_t dst_len);
+
+/**
+ * @brief Same as `alea_sample_hwt_int64_array`, which needs no workspace.
  *
- * In this function, we sample integers from the binomial distribution Bin(2 *
- * n, 0.5), shifted to have a mean of zero, where n is `cbd_num_flips`. The
- * resulting integers will be in the range [-n, n]. For large n, the
- * distribution approaches a normal distribution with mean zero and standard
- * deviation sqrt(n/2). For example, if `cbd_num_flips` is 21, the function will
- * generate integers approximately from the normal distribution with mean 0 and
- * standard deviation 3.24.
+ * Provided for symmetry with the int32 and int8 variants: `workspace` is
+ * ignored and may be `NULL`, since 64-bit entries leave room to work in `dst`.
  *
- * Algorithmically, this can be implemented by sampling from two independent
- * binomial distributions Bin(n, 0.5) and subtracting the second sample from the
+ * The int32 and int8 variants use `workspace` instead of allocating one. It
+ * is cleared before returning, may be reused across calls, but not shared
+ * between concurrent calls.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where random integers will be
+ * stored.
+ * @param dst_len The number of 64-bit integers to generate and store in the
+ * destination array.
+ * @param hwt The Hamming weight (number of nonzero entries set to ±1) for each
+ * integer.
+ * @param workspace Ignored; may be `NULL`.
+ * @return An `alea_return` code indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_sample_hwt_int64_array_workspace(
+    alea_state *state, int64_t *const dst, const size_t dst_len, const int hwt,
+    void *workspace);
+
+/**
+ * @brief Same as `alea_sample_hwt_int32_array`, but uses a caller-provided
+ * workspace.
+ *
+ * See `alea_sample_hwt_int64_array_workspace` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where random integers will be
+ * stored.
+ * @param dst_len The number of 32-bit integers to generate and store in the
+ * destination array.
+ * @param hwt The Hamming weight (number of nonzero entries set to ±1) for each
+ * integer.
+ * @param workspace At least `alea_hwt_workspace_size(dst_len)` bytes, suitably
+ * aligned for any object type (as returned by `malloc`).
+ * @return An `alea_return` code indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_sample_hwt_int32_array_workspace(
+    alea_state *state, int32_t *const dst, const size_t dst_len, const int hwt,
+    void *workspace);
+
+/**
+ * @brief Same as `alea_sample_hwt_int8_array`, but uses a caller-provided
+ * workspace.
+ *
+ * See `alea_sample_hwt_int64_array_workspace` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where random integers will be
+ * stored.
+ * @param dst_len The number of 8-bit integers to generate and store in the
+ * destination array.
+ * @param hwt The Hamming weight (number of nonzero entries set to ±1) for each
+ * integer.
+ * @param workspace At least `alea_hwt_workspace_size(dst_len)` bytes, suitably
+ * aligned for any object type (as returned by `malloc`).
+ * @return An `alea_return` code indicating success or failure of the
+ * operation.
+ */
+ALEA_API alea_return alea_sample_hwt_int8_array_workspace(
+    alea_state *state, int8_t *const dst, const size_t dst_len, const int hwt,
+    void *workspace);
+
+/**
+ * @brief The `rho` of the uniform distribution over {-1, 0, 1}, for the
+ * `alea_sample_ternary_*` functions.
+ */
+#define ALEA_TERNARY_UNIFORM (2.0 / 3.0)
+
+/**
+ * @brief Fills the destination array with random 64-bit integers sampled from
+ * the ternary distribution ZO(rho).
+ *
+ * Each entry is independently 0 with probability 1 - rho, and 1 or -1 with
+ * probability rho / 2 each. Unlike `alea_sample_hwt_int64_array`, the number of
+ * nonzero entries is not fixed.
+ *
+ * `rho` is rounded to the nearest multiple of 2^-32, so dyadic values such as
+ * 1/2 or 1/64 are exact, and `rho` must be at least 2^-33 so that it does not
+ * round to 0. Only `rho` equal to `ALEA_TERNARY_UNIFORM`, i.e. the double
+ * nearest 2/3, selects the uniform distribution over {-1, 0, 1}, which is
+ * sampled exactly by rejection; any other approximation of 2/3 is rounded
+ * like the rest. For every other `rho`, the running time depends only on
+ * `dst_len` and `rho`.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_int64_array(alea_state *state,
+                                                     int64_t *const dst,
+                                                     const size_t dst_len,
+                                                     const double rho);
+
+/**
+ * @brief Fills the destination array with random 32-bit integers sampled from
+ * the ternary distribution ZO(rho).
+ *
+ * See `alea_sample_ternary_int64_array` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_int32_array(alea_state *state,
+                                                     int32_t *const dst,
+                                                     const size_t dst_len,
+                                                     const double rho);
+
+/**
+ * @brief Fills the destination array with random 16-bit integers sampled from
+ * the ternary distribution ZO(rho).
+ *
+ * See `alea_sample_ternary_int64_array` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_int16_array(alea_state *state,
+                                                     int16_t *const dst,
+                                                     const size_t dst_len,
+                                                     const double rho);
+
+/**
+ * @brief Fills the destination array with random 8-bit integers sampled from
+ * the ternary distribution ZO(rho).
+ *
+ * See `alea_sample_ternary_int64_array` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_int8_array(alea_state *state,
+                                                    int8_t *const dst,
+                                                    const size_t dst_len,
+                                                    const double rho);
+
+/**
+ * @brief Samples `dst_len` entries from the ternary distribution ZO(rho) and
+ * packs them into 2 bits each.
+ *
+ * Entry i is stored in bits 2 * (i % 4) and 2 * (i % 4) + 1 of `dst[i / 4]`
+ * as a 2-bit two's complement integer: 0 is `00`, 1 is `01` and -1 is `11`.
+ * Unused bits of the last byte are set to zero. See
+ * `alea_sample_ternary_int64_array` for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of (`dst_len` + 3) / 4 bytes.
+ * @param dst_len Number of entries to generate.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_packed(alea_state *state,
+                                                uint8_t *const dst,
+                                                const size_t dst_len,
+                                                const double rho);
+
+/**
+ * @brief Samples `dst_len` bits from the Bernoulli distribution with
+ * probability p / 2^precision and packs them 8 per byte.
+ *
+ * Bit i is stored in bit i % 8 of `dst[i / 8]`; unused bits of the last byte
+ * are set to zero. Each bit is 1 iff a uniform `precision`-bit integer is below
+ * `p`, and 64 bits are decided at once by a bitsliced comparison, so each bit
+ * costs `precision` random bits. The running time depends only on `dst_len`
+ * and `precision`, not on `p`.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of (`dst_len` + 7) / 8 bytes.
+ * @param dst_len Number of bits to generate.
+ * @param p Probability of a 1 as a fixed-point number, below 2^precision.
+ * @param precision Number of fractional bits of `p`, in [1, 64].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_bernoulli_bits_array(alea_state *state,
+                                                      uint8_t *const dst,
+                                                      const size_t dst_len,
+                                                      const uint64_t p,
+                                                      const unsigned precision);
+
+/**
+ * @brief Fills the destination array with bits sampled from the Bernoulli
+ * distribution with probability p / 2^precision, one per byte.
+ *
+ * See `alea_sample_bernoulli_bits_array` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled bits (0 or 1)
+ * will be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param p Probability of a 1 as a fixed-point number, below 2^precision.
+ * @param precision Number of fractional bits of `p`, in [1, 64].
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_bernoulli_u8_array(alea_state *state,
+                                                    uint8_t *const dst,
+                                                    const size_t dst_len,
+                                                    const uint64_t p,
+                                                    const unsigned precision);
+
+/**
+ * @brief Fills the destination array with random 64-bit integers sampled from a
+ * centered binomial distribution.
+ *
+ * This function generates `dst_len` random 64-bit integers, each sampled from a
+ * centered binomial distribution (CBD). The results are written to the array
+ * pointed to by `dst`. The function uses the provided `state` for random number
+ * generation.
+ *
+ * @details A _centered binomial distribution_ (CBD) is a binomial distribution
+ * that is symmetric around its mean. Essentially, this can be understood as
+ * a binomial distribution with a probability of success p = 0.5, i.e., coin
+ * tosses. As the number of flips increases, the distribution approaches a
+ * normal distribution.
+ *
+ * In this function, we sample integers from the binomial distribution Bin(2 *
+ * n, 0.5), shifted to have a mean of zero, where n is `cbd_num_flips`. The
+ * resulting integers will be in the range [-n, n]. For large n, the
+ * distribution approaches a normal distribution with mean zero and standard
+ * deviation sqrt(n/2). For example, if `cbd_num_flips` is 21, the function will
+ * generate integers approximately from the normal distribution with mean 0 and
+ * standard deviation 3.24.
+ *
+ * Algorithmically, this can be implemented by sampling from two independent
+ * binomial distributions Bin(n, 0.5) and subtracting the second sample from the
+ * first.
+ *
+ * Any number of flips is supported, including more than 64. The running time
+ * depends only on `dst_len` and `cbd_num_flips`.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param cbd_num_flips The number of coin flips in a single instance. As
+ * discussed in the details section, we sample from two such instances and
+ * subtract one from the other. This effectively gives us a centered binomial
+ * distribution with mean zero and a range approximately from `-cbd_num_flips`
+ * to `cbd_num_flips`.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_cbd_int64_array(alea_state *state,
+                                                 int64_t *const dst,
+                                                 const size_t dst_len,
+                                                 const size_t cbd_num_flips);
+
+/**
+ * @brief Fills the destination array with random 32-bit integers sampled from a
+ * centered binomial distribution.
+ *
+ * This function generates `dst_len` random 32-bit integers, each sampled from a
+ * centered binomial distribution (CBD). The results are written to the array
+ * pointed to by `dst`. The function uses the provided `state` for random number
+ * generation.
+ *
+ * @details A _centered binomial distribution_ (CBD) is a binomial distribution
+ * that is symmetric around its mean. Essentially, this can be understood as
+ * a binomial distribution with a probability of success p = 0.5, i.e., coin
+ * tosses. As the number of flips increases, the distribution approaches a
+ * normal distribution.
+ *
+ * In this function, we sample integers from the binomial distribution Bin(2 *
+ * n, 0.5), shifted to have a mean of zero, where n is `cbd_num_flips`. The
+ * resulting integers will be in the range [-n, n]. For large n, the
+ * distribution approaches a normal distribution with mean zero and standard
+ * deviation sqrt(n/2). For example, if `cbd_num_flips` is 21, the function will
+ * generate integers approximately from the normal distribution with mean 0 and
+ * standard deviation 3.24.
+ *
+ * Algorithmically, this can be implemented by sampling from two independent
+ * binomial distributions Bin(n, 0.5) and subtracting the second sample from the
  * first.
  *
+ * Any number of flips is supported, including more than 64. The running time
+ * depends only on `dst_len` and `cbd_num_flips`.
+ *
  * @param state Pointer to the `alea_state` structure representing the RNG
  * state.
  * @param dst Pointer to the destination array where the sampled integers will
@@ -490,6 +1174,48 @@ ALEA_API alea_return alea_sample_cbd_int32_array(alea_state *state,
                                                  const size_t dst_len,
                                                  const size_t cbd_num_flips);
 
+/**
+ * @brief Fills the destination array with random 16-bit integers sampled from a
+ * centered binomial distribution.
+ *
+ * See `alea_sample_cbd_int64_array` for details. `cbd_num_flips` must be at
+ * most 32767 so that every sample fits.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param cbd_num_flips The number of coin flips in a single instance.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_cbd_int16_array(alea_state *state,
+                                                 int16_t *const dst,
+                                                 const size_t dst_len,
+                                                 const size_t cbd_num_flips);
+
+/**
+ * @brief Fills the destination array with random 8-bit integers sampled from a
+ * centered binomial distribution.
+ *
+ * See `alea_sample_cbd_int64_array` for details. `cbd_num_flips` must be at
+ * most 127 so that every sample fits.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @param cbd_num_flips The number of coin flips in a single instance.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_cbd_int8_array(alea_state *state,
+                                                int8_t *const dst,
+                                                const size_t dst_len,
+                                                const size_t cbd_num_flips);
+
 /**
  * @brief Fills the destination array with random 64-bit integers sampled from a
  * rounded Gaussian (normal) distribution.
@@ -536,6 +1262,407 @@ ALEA_API alea_return alea_sample_gaussian_int32_array(alea_state *state,
                                                       const size_t dst_len,
                                                       const double stdev);
 
+/**
+ * @brief Fills the destination array with random 16-bit integers sampled from a
+ * rounded Gaussian (normal) distribution.
+ *
+ * See `alea_sample_gaussian_int64_array` for details. Samples that do not fit
+ * in 16 bits are truncated, so `stdev` should be well below 2^15 / 6.67.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array. Must be even.
+ * @param stdev Standard deviation of the Gaussian distribution.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_gaussian_int16_array(alea_state *state,
+                                                      int16_t *const dst,
+                                                      const size_t dst_len,
+                                                      const double stdev);
+
+/**
+ * @brief Fills the destination array with random 8-bit integers sampled from a
+ * rounded Gaussian (normal) distribution.
+ *
+ * See `alea_sample_gaussian_int64_array` for details. Samples that do not fit
+ * in 8 bits are truncated, so `stdev` should be well below 2^7 / 6.67.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array. Must be even.
+ * @param stdev Standard deviation of the Gaussian distribution.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_gaussian_int8_array(alea_state *state,
+                                                     int8_t *const dst,
+                                                     const size_t dst_len,
+                                                     const double stdev);
+
+/**
+ * @brief Fills the destination array with doubles sampled from the continuous
+ * Gaussian (normal) distribution with mean 0.
+ *
+ * The samples come from the Box-Muller transform of
+ * `alea_sample_gaussian_int64_array` without the final rounding. Each pair of
+ * samples uses two random 64-bit words, a 64-bit angle and a 53-bit radius
+ * draw, so the samples have full double precision and reach 8.57 standard
+ * deviations.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array where the samples will be
+ * stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array. Must be even.
+ * @param stdev Standard deviation of the Gaussian distribution.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_gaussian_double_array(alea_state *state,
+                                                       double *const dst,
+                                                       const size_t dst_len,
+                                                       const double stdev);
+
+/**
+ * @brief Builds a cumulative distribution table (CDT) for the discrete
+ * Gaussian distribution with the given parameters.
+ *
+ * The table describes the discrete Gaussian D_{Z, sigma} over the integers,
+ * with P(x) proportional to exp(-x^2 / (2 sigma^2)), truncated to
+ * |x| <= ceil(`tailcut` * `sigma`). Each entry is a `precision`-bit fixed-point
+ * tail probability. All floating-point work happens here, so sampling from the
+ * table uses integer comparisons only.
+ *
+ * @param sigma Standard deviation parameter of the distribution. Must be
+ * positive.
+ * @param tailcut Number of standard deviations kept on each side. Must be
+ * positive, and ceil(`tailcut` * `sigma`) must not exceed 65536. For a
+ * statistical distance of about 2^-64 from the untruncated distribution, use a
+ * tail cut of at least 9.5.
+ * @param precision Number of bits of each fixed-point probability, from 1 to
+ * 64. Each sample consumes `precision` + 1 bits of randomness.
+ * @return Pointer to the new table, or `NULL` if the parameters are invalid or
+ * the allocation fails.
+ */
+ALEA_API alea_gaussian_table *alea_gaussian_table_create(
+    const double sigma, const double tailcut, const unsigned precision);
+
+/**
+ * @brief Frees a table created by `alea_gaussian_table_create`.
+ *
+ * @param table Pointer to the table to be freed.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_gaussian_table_free(alea_gaussian_table *table);
+
+/**
+ * @brief Fills the destination array with random 64-bit integers sampled from
+ * the discrete Gaussian distribution described by a CDT.
+ *
+ * Unlike `alea_sample_gaussian_int64_array`, which rounds a continuous
+ * Gaussian, the output follows the discrete Gaussian itself, up to the table's
+ * fixed-point precision and tail cut. Each sample scans the whole table with
+ * branch-free comparisons, so the running time depends only on `dst_len` and
+ * the table size.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param table Pointer to a table created by `alea_gaussian_table_create`.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_discrete_gaussian_int64_array(
+    alea_state *state, const alea_gaussian_table *table, int64_t *const dst,
+    const size_t dst_len);
+
+/**
+ * @brief Fills the destination array with random 32-bit integers sampled from
+ * the discrete Gaussian distribution described by a CDT.
+ *
+ * See `alea_sample_discrete_gaussian_int64_array` for details.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param table Pointer to a table created by `alea_gaussian_table_create`.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_discrete_gaussian_int32_array(
+    alea_state *state, const alea_gaussian_table *table, int32_t *const dst,
+    const size_t dst_len);
+
+/**
+ * @brief Fills the destination array with random 16-bit integers sampled from
+ * the discrete Gaussian distribution described by a CDT.
+ *
+ * See `alea_sample_discrete_gaussian_int64_array` for details. The table's
+ * bound ceil(`tailcut` * `sigma`) must be at most 32767.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param table Pointer to a table created by `alea_gaussian_table_create`.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_discrete_gaussian_int16_array(
+    alea_state *state, const alea_gaussian_table *table, int16_t *const dst,
+    const size_t dst_len);
+
+/**
+ * @brief Fills the destination array with random 8-bit integers sampled from
+ * the discrete Gaussian distribution described by a CDT.
+ *
+ * See `alea_sample_discrete_gaussian_int64_array` for details. The table's
+ * bound ceil(`tailcut` * `sigma`) must be at most 127.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param table Pointer to a table created by `alea_gaussian_table_create`.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_discrete_gaussian_int8_array(
+    alea_state *state, const alea_gaussian_table *table, int8_t *const dst,
+    const size_t dst_len);
+
+/**
+ * @brief Creates a sampler for the discrete Gaussian D_{Z, sigma, c} with a
+ * fixed `sigma` and per-sample centers c.
+ *
+ * The sampler combines draws from small constant-time CDT samplers by
+ * convolution, following Micciancio and Walter, "Gaussian Sampling over the
+ * Integers: Efficient, Generic, Constant-Time" (CRYPTO 2017). A centered
+ * sample of width at least `sigma` is built from 2^L draws at sigma = 12,
+ * where L <= 4 is the smallest level count that reaches `sigma`; it is scaled
+ * and added to the center, and the fractional part of the sum is rounded off
+ * with 32 draws at sigma = 4. All floating-point work happens here.
+ *
+ * @param sigma Standard deviation parameter of the distribution, from 4.62 to
+ * 2^45. For smaller values, use `alea_gaussian_table_create`.
+ * @return Pointer to the new sampler, or `NULL` if `sigma` is out of range or
+ * the allocation fails.
+ */
+ALEA_API alea_gaussian_sampler *
+alea_gaussian_sampler_create(const double sigma);
+
+/**
+ * @brief Frees a sampler created by `alea_gaussian_sampler_create`.
+ *
+ * @param sampler Pointer to the sampler to be freed.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_gaussian_sampler_free(alea_gaussian_sampler *sampler);
+
+/**
+ * @brief Fills the destination array with random 64-bit integers, where
+ * `dst[i]` is sampled from the discrete Gaussian centered at `centers[i]`.
+ *
+ * Sampling uses integer arithmetic only. The running time depends on
+ * `dst_len` and the sampler's level count, but not on the centers or the
+ * sampled values. Centers are used with 32 fractional bits of precision.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param sampler Pointer to a sampler created by
+ * `alea_gaussian_sampler_create`.
+ * @param centers Array of `dst_len` centers, each less than 2^62 in absolute
+ * value, or `NULL` to center every sample at 0.
+ * @param dst Pointer to the destination array where the sampled integers will
+ * be stored.
+ * @param dst_len Number of elements to generate and store in the destination
+ * array.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_discrete_gaussian_center_int64_array(
+    alea_state *state, const alea_gaussian_sampler *sampler,
+    const double *centers, int64_t *const dst, const size_t dst_len);
+
+/**
+ * @brief Samples `dst_len` integers from a centered binomial distribution and
+ * writes their residues modulo every modulus of an RNS basis.
+ *
+ * The integers are the ones `alea_sample_cbd_int64_array` would sample, and
+ * residue l of integer i is written to `dst[l * dst_len + i]`. Sampling and
+ * reduction are fused into one pass over `dst`, so no int64 array is written
+ * and read back.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_moduli * dst_len`
+ * residues.
+ * @param dst_len Number of integers to sample.
+ * @param cbd_num_flips The number of coin flips in a single instance. See
+ * `alea_sample_cbd_int64_array`.
+ * @param moduli Array of `num_moduli` moduli, each in [2, 2^63).
+ * @param num_moduli Number of moduli, at least 1.
+ * @param repr Representation of the residues.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_cbd_rns(alea_state *state, uint64_t *const dst,
+                                         const size_t dst_len,
+                                         const size_t cbd_num_flips,
+                                         const uint64_t *moduli,
+                                         const size_t num_moduli,
+                                         const alea_repr repr);
+
+/**
+ * @brief Samples `dst_len` integers from a rounded Gaussian distribution and
+ * writes their residues modulo every modulus of an RNS basis.
+ *
+ * See `alea_sample_cbd_rns` for the layout and
+ * `alea_sample_gaussian_int64_array` for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_moduli * dst_len`
+ * residues.
+ * @param dst_len Number of integers to sample. Must be even.
+ * @param stdev The standard deviation of the Gaussian distribution.
+ * @param moduli Array of `num_moduli` moduli, each in [2, 2^63).
+ * @param num_moduli Number of moduli, at least 1.
+ * @param repr Representation of the residues.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_gaussian_rns(alea_state *state,
+                                              uint64_t *const dst,
+                                              const size_t dst_len,
+                                              const double stdev,
+                                              const uint64_t *moduli,
+                                              const size_t num_moduli,
+                                              const alea_repr repr);
+
+/**
+ * @brief Samples a vector of specified Hamming weight and writes its residues
+ * modulo every modulus of an RNS basis.
+ *
+ * See `alea_sample_cbd_rns` for the layout and `alea_sample_hwt_int64_array`
+ * for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_moduli * dst_len`
+ * residues.
+ * @param dst_len Length of the vector.
+ * @param hwt The Hamming weight, from 1 to `dst_len`.
+ * @param moduli Array of `num_moduli` moduli, each in [2, 2^63).
+ * @param num_moduli Number of moduli, at least 1.
+ * @param repr Representation of the residues.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_hwt_rns(alea_state *state, uint64_t *const dst,
+                                         const size_t dst_len, const int hwt,
+                                         const uint64_t *moduli,
+                                         const size_t num_moduli,
+                                         const alea_repr repr);
+
+/**
+ * @brief Samples `dst_len` entries from the ternary distribution ZO(rho) and
+ * writes their residues modulo every modulus of an RNS basis.
+ *
+ * See `alea_sample_cbd_rns` for the layout and
+ * `alea_sample_ternary_int64_array` for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the destination array of `num_moduli * dst_len`
+ * residues.
+ * @param dst_len Number of entries to sample.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @param moduli Array of `num_moduli` moduli, each in [2, 2^63).
+ * @param num_moduli Number of moduli, at least 1.
+ * @param repr Representation of the residues.
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_sample_ternary_rns(alea_state *state,
+                                             uint64_t *const dst,
+                                             const size_t dst_len,
+                                             const double rho,
+                                             const uint64_t *moduli,
+                                             const size_t num_moduli,
+                                             const alea_repr repr);
+
+/**
+ * @brief Samples `dst_len` integers from a centered binomial distribution and
+ * adds them to the polynomial `dst` modulo `q`.
+ *
+ * `dst` holds residues in [0, q) and is updated in place: entry i becomes
+ * (dst[i] + e_i) mod q, where e_i is drawn as by
+ * `alea_sample_cbd_int64_array`. Compared with sampling into a temporary
+ * array and adding it afterwards, this needs no N-entry temporary and makes a
+ * single pass over `dst`. The reduction has no branches on the samples.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the array of `dst_len` residues to add the noise to.
+ * @param dst_len Number of entries to sample.
+ * @param cbd_num_flips Number of coin flips per sample.
+ * @param q Modulus, in [2, 2^63).
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_add_cbd_mod_q(alea_state *state, uint64_t *const dst,
+                                        const size_t dst_len,
+                                        const size_t cbd_num_flips,
+                                        const uint64_t q);
+
+/**
+ * @brief Samples `dst_len` integers from a Gaussian distribution and adds them
+ * to the polynomial `dst` modulo `q`.
+ *
+ * See `alea_add_cbd_mod_q` for details and
+ * `alea_sample_gaussian_int64_array` for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the array of `dst_len` residues to add the noise to.
+ * @param dst_len Number of entries to sample. Must be even.
+ * @param stdev Standard deviation of the Gaussian distribution.
+ * @param q Modulus, in [2, 2^63).
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_add_gaussian_mod_q(alea_state *state,
+                                             uint64_t *const dst,
+                                             const size_t dst_len,
+                                             const double stdev,
+                                             const uint64_t q);
+
+/**
+ * @brief Samples `dst_len` entries from the ternary distribution ZO(rho) and
+ * adds them to the polynomial `dst` modulo `q`.
+ *
+ * See `alea_add_cbd_mod_q` for details and
+ * `alea_sample_ternary_int64_array` for the distribution.
+ *
+ * @param state Pointer to the `alea_state` structure representing the RNG
+ * state.
+ * @param dst Pointer to the array of `dst_len` residues to add the noise to.
+ * @param dst_len Number of entries to sample.
+ * @param rho Probability of a nonzero entry, in [2^-33, 1].
+ * @param q Modulus, in [2, 2^63).
+ * @return An `alea_return` code indicating success or failure of the operation.
+ */
+ALEA_API alea_return alea_add_ternary_mod_q(alea_state *state,
+                                            uint64_t *const dst,
+                                            const size_t dst_len,
+                                            const double rho,
+                                            const uint64_t q);
+
 /**
  * @brief Generates a key using the HMAC-based Key Derivation Function (HKDF).
  *
@@ -16,6 +16,7 @@
 
 #define ALEA_STATE_IMPLEMENTATION
 
+#include "alea-internal.h"
 #include "alea/algorithms.h"
 #include "fips202.h"
 
@@ -23,51 +24,116 @@
 #include <stdlib.h>
 #include <string.h>
 
+typedef struct alea_builtin_ops alea_builtin_ops;
+
 typedef struct {
   alea_algo algorithm;
+  const alea_builtin_ops *ops;
   uint8_t *data;
   size_t len;
   size_t loc;
   keccak_state *state;
+  alea_bit_cursor bits;
 } alea_state;
 
 #include "alea-builtin.h"
-#include "alea-internal.h"
 #include "alea/alea.h"
 
-static alea_state *alea_init_builtin_SHAKE128(const uint8_t *seed) {
-  alea_state *new = malloc(sizeof(alea_state));
-  if (new == NULL)
-    return NULL;
-
-  new->algorithm = ALEA_ALGORITHM_SHAKE128;
-  new->len = SHAKE128_RATE;
-  new->loc = 0;
-  new->data = malloc(new->len * sizeof(*(new->data)));
-  if (new->data == NULL) {
-    free(new);
-    return NULL;
-  }
-  new->state = malloc(sizeof(keccak_state));
-  if (new->state == NULL) {
-    free(new->data);
-    free(new);
-    return NULL;
-  }
-
-  shake128_absorb_once(new->state, seed, ALEA_SEED_SIZE_SHAKE128);
-  shake128_squeezeblocks(new->data, 1, new->state);
-
-  return new;
-}
-
-static alea_state *alea_init_builtin_SHAKE256(const uint8_t *seed) {
+// Per-algorithm implementations of the paths that run on every refill. Each
+// instance is compiled with its rate as a constant, so the block copies and
+// the squeeze loop are specialized for it, and `alea_init_builtin` binds one
+// to the state. Nothing below branches on the algorithm after that. Whole
+// blocks are squeezed (or XORed) straight into the caller's buffer; the
+// stream is the same as when every byte goes through `data`.
+struct alea_builtin_ops {
+  alea_algo algorithm;
+  size_t rate;
+  void (*reseed)(alea_state *state, const uint8_t *seed);
+  void (*resqueeze)(alea_state *state);
+  alea_return (*get_random_bytes)(alea_state *state, uint8_t *const dst,
+                                  const size_t dst_len);
+  alea_return (*xor_random_bytes)(alea_state *state, uint8_t *const buf,
+                                  const size_t buf_len);
+};
+
+#define ALEA_DEFINE_BUILTIN_OPS(BITS)                                          \
+  static void alea_resqueeze_##BITS(alea_state *state) {                       \
+    shake##BITS##_squeezeblocks(state->data, 1, state->state);                 \
+    state->loc = 0;                                                            \
+  }                                                                            \
+                                                                               \
+  static void alea_reseed_##BITS(alea_state *state, const uint8_t *seed) {     \
+    shake##BITS##_absorb_once(state->state, seed, ALEA_SEED_SIZE_SHAKE##BITS); \
+    alea_resqueeze_##BITS(state);                                              \
+    alea_bit_cursor_init(&state->bits);                                        \
+  }                                                                            \
+                                                                               \
+  static alea_return alea_get_random_bytes_##BITS(                             \
+      alea_state *state, uint8_t *const dst, const size_t dst_len) {           \
+    const size_t rate = SHAKE##BITS##_RATE;                                    \
+    if (dst_len <= rate - state->loc) {                                        \
+      memcpy(dst, state->data + state->loc, dst_len);                          \
+      state->loc += dst_len;                                                   \
+      return ALEA_RETURN_OK;                                                   \
+    }                                                                          \
+                                                                               \
+    const size_t head = rate - state->loc;                                     \
+    memcpy(dst, state->data + state->loc, head);                               \
+    const size_t nblocks = (dst_len - head) / rate;                            \
+    shake##BITS##_squeezeblocks(dst + head, nblocks, state->state);            \
+    const size_t done = head + nblocks * rate;                                 \
+    state->loc = rate;                                                         \
+    if (done < dst_len) {                                                      \
+      alea_resqueeze_##BITS(state);                                            \
+      memcpy(dst + done, state->data, dst_len - done);                         \
+      state->loc = dst_len - done;                                             \
+    }                                                                          \
+    return ALEA_RETURN_OK;                                                     \
+  }                                                                            \
+                                                                               \
+  static alea_return alea_xor_random_bytes_##BITS(                             \
+      alea_state *state, uint8_t *const buf, const size_t buf_len) {           \
+    const size_t rate = SHAKE##BITS##_RATE;                                    \
+    size_t done = rate - state->loc;                                           \
+    if (done > buf_len)                                                        \
+      done = buf_len;                                                          \
+    for (size_t i = 0; i < done; i++)                                          \
+      buf[i] ^= state->data[state->loc + i];                                   \
+    state->loc += done;                                                        \
+                                                                               \
+    const size_t nblocks = (buf_len - done) / rate;                            \
+    shake##BITS##_xorblocks(buf + done, nblocks, state->state);                \
+    done += nblocks * rate;                                                    \
+    if (done < buf_len) {                                                      \
+      alea_resqueeze_##BITS(state);                                            \
+      for (size_t i = 0; done + i < buf_len; i++)                              \
+        buf[done + i] ^= state->data[i];                                       \
+      state->loc = buf_len - done;                                             \
+    }                                                                          \
+    return ALEA_RETURN_OK;                                                     \
+  }                                                                            \
+                                                                               \
+  static const alea_builtin_ops alea_builtin_ops_##BITS = {                    \
+      ALEA_ALGORITHM_SHAKE##BITS,                                              \
+      SHAKE##BITS##_RATE,                                                      \
+      alea_reseed_##BITS,                                                      \
+      alea_resqueeze_##BITS,                                                   \
+      alea_get_random_bytes_##BITS,                                            \
+      alea_xor_random_bytes_##BITS,                                            \
+  };
+
+ALEA_DEFINE_BUILTIN_OPS(128)
+ALEA_DEFINE_BUILTIN_OPS(256)
+
+static alea_state *alea_init_builtin_ops(const alea_builtin_ops *ops,
+                                         const uint8_t *seed) {
   alea_state *new = malloc(sizeof(alea_state));
   if (new == NULL)
     return NULL;
 
-  new->algorithm = ALEA_ALGORITHM_SHAKE256;
-  new->len = SHAKE256_RATE;
+  new->algorithm = ops->algorithm;
+  new->ops = ops;
+  new->len = ops->rate;
   new->loc = 0;
   new->data = malloc(new->len * sizeof(*(new->data)));
   if (new->data == NULL) {
@@ -81,8 +147,7 @@ static alea_state *alea_init_builtin_SHAKE256(const uint8_t *seed) {
     return NULL;
   }
 
-  shake256_absorb_once(new->state, seed, ALEA_SEED_SIZE_SHAKE256);
-  shake256_squeezeblocks(new->data, 1, new->state);
+  ops->reseed(new, seed);
 
   return new;
 }
@@ -90,9 +155,9 @@ static alea_state *alea_init_builtin_SHAKE256(const uint8_t *seed) {
 alea_state *alea_init_builtin(const uint8_t *const seed,
                               const alea_algo algorithm) {
   if (algorithm == ALEA_ALGORITHM_SHAKE128)
-    return alea_init_builtin_SHAKE128(seed);
+    return alea_init_builtin_ops(&alea_builtin_ops_128, seed);
   else if (algorithm == ALEA_ALGORITHM_SHAKE256)
-    return alea_init_builtin_SHAKE256(seed);
+    return alea_init_builtin_ops(&alea_builtin_ops_256, seed);
 
   return NULL;
 }
@@ -106,45 +171,40 @@ alea_return alea_free_builtin(alea_state *state) {
 }
 
 alea_return alea_reseed_builtin(alea_state *state, const uint8_t *const seed) {
-  if (state->algorithm == ALEA_ALGORITHM_SHAKE128) {
-    shake128_absorb_once(state->state, seed, ALEA_SEED_SIZE_SHAKE128);
-    shake128_squeezeblocks(state->data, 1, state->state);
-    state->loc = 0;
-  } else if (state->algorithm == ALEA_ALGORITHM_SHAKE256) {
-    shake256_absorb_once(state->state, seed, ALEA_SEED_SIZE_SHAKE256);
-    shake256_squeezeblocks(state->data, 1, state->state);
-    state->loc = 0;
-  }
+  state->ops->reseed(state, seed);
 
   return ALEA_RETURN_OK;
 }
 
-static void resqueeze(alea_state *state) {
-  if (state->algorithm == ALEA_ALGORITHM_SHAKE128) {
-    shake128_squeezeblocks(state->data, 1, state->state);
-    state->loc = 0;
-  } else if (state->algorithm == ALEA_ALGORITHM_SHAKE256) {
-    shake256_squeezeblocks(state->data, 1, state->state);
-    state->loc = 0;
-  }
+alea_bit_cursor *alea_get_bit_cursor_builtin(alea_state *state) {
+  return &state->bits;
 }
 
 alea_return alea_get_random_bytes_builtin(alea_state *state, uint8_t *const dst,
                                           const size_t dst_len) {
+  return state->ops->get_random_bytes(state, dst, dst_len);
+}
+
+alea_return alea_xor_random_bytes_builtin(alea_state *state, uint8_t *const buf,
+                                          const size_t buf_len) {
+  return state->ops->xor_random_bytes(state, buf, buf_len);
+}
 
+const uint8_t *alea_peek_builtin(alea_state *state, size_t *avail) {
   if (state->loc == state->len) {
-    resqueeze(state);
+    state->ops->resqueeze(state);
   }
 
-  if (state->loc + dst_len <= state->len) {
-    memcpy(dst, state->data + state->loc, dst_len);
-    state->loc += dst_len;
-    return ALEA_RETURN_OK;
-  }
+  *avail = state->len - state->loc;
+  return state->data + state->loc;
+}
 
-  const size_t diff = state->len - state->loc;
-  memcpy(dst, state->data + state->loc, diff);
-  state->loc = state->len;
+alea_return alea_consume_builtin(alea_state *state, const size_t n) {
+  // Checked in release builds too: loc past len would read beyond the block.
+  if (n > state->len - state->loc) {
+    return ALEA_RETURN_BAD_GENERIC;
+  }
 
-  return alea_get_random_bytes_builtin(state, dst + diff, dst_len - diff);
+  state->loc += n;
+  return ALEA_RETURN_OK;
 }
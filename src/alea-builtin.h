@@ -17,6 +17,7 @@
 #ifndef ALEA_ALEA_BUILTIN_H
 #define ALEA_ALEA_BUILTIN_H
 
+#include "alea-internal.h"
 #include "alea/alea.h"
 
 alea_state *alea_init_builtin(const uint8_t *const seed,
@@ -25,5 +26,10 @@ alea_return alea_free_builtin(alea_state *state);
 alea_return alea_reseed_builtin(alea_state *state, const uint8_t *const seed);
 alea_return alea_get_random_bytes_builtin(alea_state *state, uint8_t *const dst,
                                           const size_t dst_len);
+alea_return alea_xor_random_bytes_builtin(alea_state *state, uint8_t *const buf,
+                                          const size_t buf_len);
+const uint8_t *alea_peek_builtin(alea_state *state, size_t *avail);
+alea_return alea_consume_builtin(alea_state *state, const size_t n);
+alea_bit_cursor *alea_get_bit_cursor_builtin(alea_state *state);
 
 #endif // ALEA_ALEA_BUILTIN_H
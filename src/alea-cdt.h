@@ -0,0 +1,56 @@
+/*
+ * Copyright 2025 CryptoLab, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ALEA_ALEA_CDT_H
+#define ALEA_ALEA_CDT_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fills cdt[k - 1] with P(|x - offset| >= k + offset) for x sampled from
+// D_{Z, sigma, offset}, for k = 1..len, as `precision`-bit fixed-point values.
+// The offset is 0 or 1/2; for 1/2, magnitude m stands for x = m + 1 and x = -m.
+// The sampler generator in src/codegen builds its tables here too, so generated
+// samplers match `alea_gaussian_table` bit for bit.
+inline static void alea_cdt_fill(uint64_t *cdt, const size_t len,
+                                 const double sigma, const double offset,
+                                 const unsigned precision) {
+  // rho(m) = exp(-(m + offset)^2 / (2 sigma^2)). Every magnitude has two
+  // points, except m = 0 with a zero offset, where rho(0) = 1 counts once.
+  double total =
+      offset == 0 ? 1.0 : 2.0 * exp(-offset * offset / (2.0 * sigma * sigma));
+  for (size_t k = len; k > 0; k--) {
+    const double m = (double)k + offset;
+    total += 2.0 * exp(-m * m / (2.0 * sigma * sigma));
+  }
+
+  // Tail masses are accumulated from the outside in, so that small entries
+  // keep their full relative precision. Entries that round up to 2^precision
+  // saturate at 2^precision - 1: they must fit in `precision` bits, and a
+  // draw of all ones still gives magnitude 0.
+  const double limit = ldexp(1.0, (int)precision);
+  const uint64_t max = ~UINT64_C(0) >> (64 - precision);
+  double tail = 0;
+  for (size_t k = len; k > 0; k--) {
+    const double m = (double)k + offset;
+    tail += 2.0 * exp(-m * m / (2.0 * sigma * sigma));
+    const double scaled = ldexp(tail / total, (int)precision) + 0.5;
+    cdt[k - 1] = scaled >= limit ? max : (uint64_t)scaled;
+  }
+}
+
+#endif // ALEA_ALEA_CDT_H
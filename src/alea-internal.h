@@ -22,9 +22,58 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 static inline void safe_free(void *ptr, size_t ptr_len) {
   memset(ptr, 0, ptr_len);
   free(ptr);
 }
 
+// A bit-level cursor over the output stream. Every state owns one, so samplers
+// that need only a few bits per draw take exactly that many bits, and bits left
+// over at the end of a call are used by the next. Words are fetched from the
+// stream ALEA_BIT_CURSOR_WORDS at a time.
+#define ALEA_BIT_CURSOR_WORDS 8
+
+typedef struct {
+  uint64_t buf[ALEA_BIT_CURSOR_WORDS];
+  size_t pos;     // next unread word in `buf`
+  uint64_t word;  // unread bits of the current word, LSB first
+  unsigned avail; // number of unread bits in `word`
+} alea_bit_cursor;
+
+static inline void alea_bit_cursor_init(alea_bit_cursor *cur) {
+  memset(cur->buf, 0, sizeof(cur->buf));
+  cur->pos = ALEA_BIT_CURSOR_WORDS;
+  cur->word = 0;
+  cur->avail = 0;
+}
+
+// Computes the full 128-bit product of `a` and `b`. The high 64 bits are
+// returned and the low 64 bits are written to `lo`.
+static inline uint64_t alea_mul_hi64(const uint64_t a, const uint64_t b,
+                                     uint64_t *lo) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 alea_uint128;
+  const alea_uint128 m = (alea_uint128)a * b;
+  *lo = (uint64_t)m;
+  return (uint64_t)(m >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  uint64_t hi;
+  *lo = _umul128(a, b, &hi);
+  return hi;
+#else
+  const uint64_t a_lo = a & UINT64_C(0xFFFFFFFF), a_hi = a >> 32;
+  const uint64_t b_lo = b & UINT64_C(0xFFFFFFFF), b_hi = b >> 32;
+  const uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi;
+  const uint64_t p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+  const uint64_t mid =
+      (p0 >> 32) + (p1 & UINT64_C(0xFFFFFFFF)) + (p2 & UINT64_C(0xFFFFFFFF));
+  *lo = (mid << 32) | (p0 & UINT64_C(0xFFFFFFFF));
+  return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
 #endif // ALEA_ALEA_INTERNAL_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 CryptoLab, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "alea-sort.h"
+
+// The network is the portable one from djbsort (https://sorting.cr.yp.to/),
+// a merge network that works for any n, not only powers of two. The
+// comparators of each step are grouped into runs of consecutive i with i & p
+// clear. Comparators within a run touch disjoint elements, so a run can be
+// done one distance at a time, which keeps the inner loop contiguous and lets
+// the compiler vectorize it. The network itself is unchanged.
+
+// 1 if a < b, else 0, computed without a comparison instruction: the top bit
+// of a - b is the borrow whenever a and b agree in their top bit.
+#define ALEA_CT_LT(TYPE, BITS, a, b)                                           \
+  ((TYPE)((~(a) & (b)) | (~((a) ^ (b)) & (TYPE)((a) - (b)))) >> ((BITS) - 1))
+
+#define ALEA_CT_SORT(TYPE, BITS)                                               \
+  inline static void alea_ct_minmax_##BITS(TYPE *a, TYPE *b, TYPE *va,         \
+                                           TYPE *vb) {                         \
+    const TYPE swap = (TYPE)0 - ALEA_CT_LT(TYPE, BITS, *b, *a);                \
+    const TYPE d = (*a ^ *b) & swap;                                           \
+    *a ^= d;                                                                   \
+    *b ^= d;                                                                   \
+    if (va != NULL) {                                                          \
+      const TYPE dv = (*va ^ *vb) & swap;                                      \
+      *va ^= dv;                                                               \
+      *vb ^= dv;                                                               \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  inline static void alea_ct_minmax_run_##BITS(TYPE *keys, TYPE *vals,         \
+                                               size_t lo, size_t hi,           \
+                                               size_t d) {                     \
+    if (vals == NULL) {                                                        \
+      for (size_t i = lo; i < hi; ++i) {                                       \
+        alea_ct_minmax_##BITS(keys + i, keys + i + d, NULL, NULL);             \
+      }                                                                        \
+    } else {                                                                   \
+      for (size_t i = lo; i < hi; ++i) {                                       \
+        alea_ct_minmax_##BITS(keys + i, keys + i + d, vals + i,                \
+                              vals + i + d);                                   \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void alea_ct_sort_uint##BITS(TYPE *keys, TYPE *vals, size_t n) {             \
+    if (n < 2)                                                                 \
+      return;                                                                  \
+                                                                               \
+    size_t top = 1;                                                            \
+    while (top < n - top) {                                                    \
+      top += top;                                                              \
+    }                                                                          \
+                                                                               \
+    for (size_t p = top; p > 0; p >>= 1) {                                     \
+      for (size_t j = 0; j < n - p; j += 2 * p) {                              \
+        const size_t hi = j + p < n - p ? j + p : n - p;                       \
+        alea_ct_minmax_run_##BITS(keys, vals, j, hi, p);                       \
+      }                                                                        \
+      size_t i = 0;                                                            \
+      for (size_t q = top; q > p; q >>= 1) {                                   \
+        while (i < n - q) {                                                    \
+          if (i & p) {                                                         \
+            i = (i | (p - 1)) + 1;                                             \
+            continue;                                                          \
+          }                                                                    \
+          const size_t end = (i | (p - 1)) + 1;                                \
+          const size_t hi = end < n - q ? end : n - q;                         \
+          for (size_t r = q; r > p; r >>= 1) {                                 \
+            alea_ct_minmax_run_##BITS(keys + p, vals ? vals + p : NULL, i, hi, \
+                                      r - p);                                  \
+          }                                                                    \
+          i = hi;                                                              \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+  }
+
+ALEA_CT_SORT(uint32_t, 32)
+ALEA_CT_SORT(uint64_t, 64)
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 CryptoLab, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ALEA_ALEA_SORT_H
+#define ALEA_ALEA_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sort `keys` in ascending order with a sorting network. The sequence of
+// compare-exchange operations and memory accesses depends only on `n`, and
+// each compare-exchange is branch-free, so the running time does not depend
+// on the data. If `vals` is not NULL, vals[i] is moved along with keys[i].
+void alea_ct_sort_uint32(uint32_t *keys, uint32_t *vals, size_t n);
+void alea_ct_sort_uint64(uint64_t *keys, uint64_t *vals, size_t n);
+
+#endif // ALEA_ALEA_SORT_H
@@ -15,8 +15,10 @@
  */
 
 #include "alea/alea.h"
+#include "alea-cdt.h"
 #include "alea-hkdf.h"
 #include "alea-internal.h"
+#include "alea-sort.h"
 
 #include <assert.h>
 #include <math.h>
@@ -43,6 +45,23 @@ alea_return alea_get_random_bytes(alea_state *state, uint8_t *const dst,
   return alea_get_random_bytes_builtin(state, dst, dst_len);
 }
 
+alea_return alea_xor_random_bytes(alea_state *state, uint8_t *const buf,
+                                  const size_t buf_len) {
+  return alea_xor_random_bytes_builtin(state, buf, buf_len);
+}
+
+const uint8_t *alea_peek(alea_state *state, size_t *avail) {
+  return alea_peek_builtin(state, avail);
+}
+
+alea_return alea_consume(alea_state *state, const size_t n) {
+  return alea_consume_builtin(state, n);
+}
+
+inline static alea_bit_cursor *alea_get_bit_cursor(alea_state *state) {
+  return alea_get_bit_cursor_builtin(state);
+}
+
 #else
 #error "Not supported"
 #endif
@@ -61,38 +80,96 @@ uint32_t alea_get_random_uint32(alea_state *state) {
   return res;
 }
 
+#ifndef __has_builtin
+#define __has_builtin(arg) 0
+#endif
+
+// Number of bits needed to represent `x`, i.e. ceil(log2(x + 1)).
+inline static unsigned alea_bit_length(uint64_t x) {
+#if __has_builtin(__builtin_clzll)
+  return x == 0 ? 0 : 64 - (unsigned)__builtin_clzll(x);
+#else
+  unsigned len = 0;
+  while (x != 0) {
+    len++;
+    x >>= 1;
+  }
+  return len;
+#endif
+}
+
+// Returns `nbits` (1 to 64) random bits in the low bits of the result.
+inline static uint64_t alea_bit_cursor_get(alea_state *state,
+                                           alea_bit_cursor *cur,
+                                           const unsigned nbits) {
+  const uint64_t mask = ~UINT64_C(0) >> (64 - nbits);
+
+  if (cur->avail >= nbits) {
+    const uint64_t res = cur->word & mask;
+    // Two shifts so that nbits = 64 does not shift by the full width.
+    cur->word = (cur->word >> (nbits - 1)) >> 1;
+    cur->avail -= nbits;
+    return res;
+  }
+
+  if (cur->pos == ALEA_BIT_CURSOR_WORDS) {
+    alea_get_random_bytes(state, (uint8_t *)cur->buf, sizeof(cur->buf));
+    cur->pos = 0;
+  }
+  const uint64_t next = cur->buf[cur->pos++];
+  const unsigned need = nbits - cur->avail; // 1 to 64, avail < 64
+  const uint64_t res = (cur->word | (next << cur->avail)) & mask;
+  cur->word = (next >> (need - 1)) >> 1;
+  cur->avail = 64 - need;
+  return res;
+}
+
+uint64_t alea_get_random_bits(alea_state *state, const unsigned nbits) {
+  assert(nbits >= 1 && nbits <= 64);
+
+  return alea_bit_cursor_get(state, alea_get_bit_cursor(state), nbits);
+}
+
+// Lemire's nearly divisionless method (https://arxiv.org/abs/1805.10941).
+//
+// For a uniform w-bit x, the 2w-bit product x * range is spread over
+// [0, range * 2^w); its high word is the sample and its low word decides
+// rejection. A draw is rejected iff the low word is below 2^w % range, which
+// leaves exactly floor(2^w / range) accepted draws for every output value.
+// Since 2^w % range < range, the threshold is only needed when the low word is
+// below `range`, so the divide is skipped on all but a range / 2^w fraction of
+// the draws.
 uint64_t alea_get_random_uint64_in_range(alea_state *state,
                                          const uint64_t range) {
   assert(range >= 2);
 
-  uint64_t res;
-  // min = 2^64 % range = (2^64 - range) % range
-  const uint64_t min = (-range) % range;
-
-  while (1) {
-    res = alea_get_random_uint64(state);
-    if (res >= min)
-      break;
+  uint64_t lo;
+  uint64_t res = alea_mul_hi64(alea_get_random_uint64(state), range, &lo);
+  if (lo < range) {
+    // min = 2^64 % range = (2^64 - range) % range
+    const uint64_t min = (-range) % range;
+    while (lo < min) {
+      res = alea_mul_hi64(alea_get_random_uint64(state), range, &lo);
+    }
   }
 
-  return res % range;
+  return res;
 }
 
 uint32_t alea_get_random_uint32_in_range(alea_state *state,
                                          const uint32_t range) {
   assert(range >= 2);
 
-  uint32_t res;
-  // min = 2^32 % range = (2^32 - range) % range
-  const uint32_t min = (-range) % range;
-
-  while (1) {
-    res = alea_get_random_uint32(state);
-    if (res >= min)
-      break;
+  uint64_t m = (uint64_t)alea_get_random_uint32(state) * range;
+  if ((uint32_t)m < range) {
+    // min = 2^32 % range = (2^32 - range) % range
+    const uint32_t min = (-range) % range;
+    while ((uint32_t)m < min) {
+      m = (uint64_t)alea_get_random_uint32(state) * range;
+    }
   }
 
-  return res % range;
+  return (uint32_t)(m >> 32);
 }
 
 alea_return alea_get_random_uint64_array(alea_state *state, uint64_t *const dst,
@@ -107,230 +184,1244 @@ alea_return alea_get_random_uint32_array(alea_state *state, uint32_t *const dst,
                                dst_len * sizeof(uint32_t));
 }
 
-alea_return alea_get_random_uint64_array_in_range(alea_state *state,
-                                                  uint64_t *const dst,
-                                                  const size_t dst_len,
-                                                  const uint64_t range) {
-  assert(range >= 2);
+// The top 53 (24) bits of each word scaled to [0, 1), so that every multiple
+// of 2^-53 (2^-24) in the interval is equally likely. The words are drawn
+// into dst and converted in place.
+alea_return alea_get_random_double_array(alea_state *state, double *const dst,
+                                         const size_t dst_len) {
+  alea_get_random_bytes(state, (uint8_t *)dst, dst_len * sizeof(double));
+  for (size_t i = 0; i < dst_len; i++) {
+    uint64_t x;
+    memcpy(&x, dst + i, sizeof(x));
+    dst[i] = (double)(x >> 11) * 0x1p-53;
+  }
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_get_random_float_array(alea_state *state, float *const dst,
+                                        const size_t dst_len) {
+  alea_get_random_bytes(state, (uint8_t *)dst, dst_len * sizeof(float));
+  for (size_t i = 0; i < dst_len; i++) {
+    uint32_t x;
+    memcpy(&x, dst + i, sizeof(x));
+    dst[i] = (float)(x >> 8) * 0x1p-24f;
+  }
+  return ALEA_RETURN_OK;
+}
 
+// Precomputed constants for sampling uniformly from [0, range). With the
+// Lemire threshold known in advance, neither path below divides per sample.
+struct alea_range_sampler {
+  uint64_t range;
+  uint64_t min;  // 2^64 % range, the rejection threshold of the Lemire path
+  unsigned bits; // ceil(log2(range)), the draw width of the bitmask path
+};
+
+inline static void alea_range_sampler_init(alea_range_sampler *sampler,
+                                           const uint64_t range) {
+  sampler->range = range;
   // min = 2^64 % range = (2^64 - range) % range
-  const uint64_t min = (-range) % range;
+  sampler->min = (-range) % range;
+  sampler->bits = alea_bit_length(range - 1);
+}
+
+// Lemire's method with a precomputed threshold.
+inline static uint64_t alea_range_sample_lemire(alea_state *state,
+                                                const alea_range_sampler *s) {
+  uint64_t lo;
+  uint64_t res;
+  do {
+    res = alea_mul_hi64(alea_get_random_uint64(state), s->range, &lo);
+  } while (lo < s->min);
+
+  return res;
+}
 
+// Ranges of at most 2^32 use bitmask rejection: draw k = ceil(log2(range))
+// bits from a bit cursor and keep them if they are below `range`. A draw is
+// accepted with probability range / 2^k > 1/2, so a sample costs fewer than 2k
+// bits on average instead of a whole 64-bit word.
+//
+// Larger ranges use Lemire's method with the threshold precomputed in `s`, so
+// the per-sample work is one multiplication and one comparison. On both paths,
+// whether a draw is rejected is independent of the value it produces.
+inline static void alea_range_fill(alea_state *state,
+                                   const alea_range_sampler *s,
+                                   uint64_t *const dst, const size_t dst_len) {
   uint64_t *it = dst;
-  while (it != dst + dst_len) {
-    *it = alea_get_random_uint64(state);
-    if (*it >= min) {
-      *it %= range;
-      it++;
+
+  if (s->bits <= 32) {
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);
+    while (it != dst + dst_len) {
+      *it = alea_bit_cursor_get(state, cur, s->bits);
+      it += (*it < s->range);
     }
+    return;
+  }
+
+  uint64_t lo;
+  while (it != dst + dst_len) {
+    *it = alea_mul_hi64(alea_get_random_uint64(state), s->range, &lo);
+    it += (lo >= s->min);
   }
+}
+
+alea_return alea_get_random_uint64_array_in_range(alea_state *state,
+                                                  uint64_t *const dst,
+                                                  const size_t dst_len,
+                                                  const uint64_t range) {
+  assert(range >= 2);
+
+  alea_range_sampler sampler;
+  alea_range_sampler_init(&sampler, range);
+  alea_range_fill(state, &sampler, dst, dst_len);
 
   return ALEA_RETURN_OK;
 }
 
+// Bitmask rejection into arrays of narrower integers, for ranges of at most
+// 2^16, with the same per-sample work as in `alea_range_fill`.
+#define ALEA_DEFINE_RANGE_BITMASK(TYPE, BITS)                                  \
+  inline static void alea_range_bitmask_##BITS(alea_state *state,              \
+                                               TYPE *const dst,                \
+                                               const size_t dst_len,           \
+                                               const uint32_t range) {         \
+    const unsigned k = alea_bit_length(range - 1);                             \
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);                         \
+                                                                               \
+    TYPE *it = dst;                                                            \
+    while (it != dst + dst_len) {                                              \
+      *it = (TYPE)alea_bit_cursor_get(state, cur, k);                          \
+      it += (*it < range);                                                     \
+    }                                                                          \
+  }
+
+ALEA_DEFINE_RANGE_BITMASK(uint32_t, 32)
+ALEA_DEFINE_RANGE_BITMASK(uint16_t, 16)
+ALEA_DEFINE_RANGE_BITMASK(uint8_t, 8)
+
+// Same as above for 32-bit outputs; the bitmask path is taken for ranges of at
+// most 2^16.
 alea_return alea_get_random_uint32_array_in_range(alea_state *state,
                                                   uint32_t *const dst,
                                                   const size_t dst_len,
                                                   const uint32_t range) {
   assert(range >= 2);
 
+  if (alea_bit_length(range - 1) <= 16) {
+    alea_range_bitmask_32(state, dst, dst_len, range);
+    return ALEA_RETURN_OK;
+  }
+
   // min = 2^32 % range = (2^32 - range) % range
   const uint32_t min = (-range) % range;
 
+  uint64_t m;
   uint32_t *it = dst;
   while (it != dst + dst_len) {
-    *it = alea_get_random_uint32(state);
-    if (*it >= min) {
-      *it %= range;
-      it++;
-    }
+    m = (uint64_t)alea_get_random_uint32(state) * range;
+    *it = (uint32_t)(m >> 32);
+    it += ((uint32_t)m >= min);
   }
 
   return ALEA_RETURN_OK;
 }
 
-// See the paper: Efficient isochronous fixed-weight sampling with applications
-// to NTRU (https://eprint.iacr.org/2024/548) for more details on fixed-weight
-// sampling
-inline static alea_return alea_rejection_sampling_mod(alea_state *state,
-                                                      int32_t *const si,
-                                                      const size_t dst_len) {
-  assert(dst_len > 0);
-  // Choosing L involves a trade-off between the cost of generating random
-  // numbers and the rate of sample rejections. A larger L reduces the rejection
-  // probability and thus improves overall sampling efficiency. Conversely, an
-  // excessively large L—or a too small L that triggers frequent
-  // rejections—increases random-number generation overhead and can introduce
-  // timing side-channels.
-  //
-  // The author choose L = 16, for n = 509, 677 and 821.
-  // We choose L = 30, under our assumption that the input `dst_len` is less
-  // than or equal to 2^17.
-  uint64_t L = 30;
-  uint64_t two_to_L = UINT32_C(1) << L;
-  assert(dst_len <= two_to_L);
-
-  memset(si, 0, dst_len * sizeof(int32_t));
-  uint64_t n = (uint64_t)dst_len;
-  uint64_t rnd, m, l, t, s;
-
-  for (uint64_t i = 0; i < n - 1; i++) {
-    s = n - 1 - i;
-    t = two_to_L % s;
-    // Unbiased uniform sampling from [0, n - 1 - i)
-    // Rejection sampling ensures that ⌊x · s/2L⌋ is unbiasedly
-    // sampled from [0, s)
-    do {
-      // uniform sampling from [0, 2^L - 1]
-      alea_get_random_bytes(state, (uint8_t *)&rnd, (L + 7) / 8);
-      rnd &= (two_to_L - 1);
-      m = rnd * s;
-      l = m & (two_to_L - 1);
-    } while (l < t);
-    si[i] = (int)(m >> L);
+alea_return alea_get_random_uint16_array_in_range(alea_state *state,
+                                                  uint16_t *const dst,
+                                                  const size_t dst_len,
+                                                  const uint32_t range) {
+  assert(range >= 2 && range <= (UINT32_C(1) << 16));
+
+  alea_range_bitmask_16(state, dst, dst_len, range);
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_get_random_uint8_array_in_range(alea_state *state,
+                                                 uint8_t *const dst,
+                                                 const size_t dst_len,
+                                                 const uint32_t range) {
+  assert(range >= 2 && range <= (UINT32_C(1) << 8));
+
+  alea_range_bitmask_8(state, dst, dst_len, range);
+  return ALEA_RETURN_OK;
+}
+
+alea_range_sampler *alea_range_sampler_create(const uint64_t range) {
+  if (range < 2)
+    return NULL;
+
+  alea_range_sampler *new = malloc(sizeof(alea_range_sampler));
+  if (new == NULL)
+    return NULL;
+
+  alea_range_sampler_init(new, range);
+  return new;
+}
+
+alea_return alea_range_sampler_free(alea_range_sampler *sampler) {
+  safe_free(sampler, sizeof(alea_range_sampler));
+  return ALEA_RETURN_OK;
+}
+
+uint64_t alea_range_sample(alea_state *state,
+                           const alea_range_sampler *sampler) {
+  return alea_range_sample_lemire(state, sampler);
+}
+
+alea_return alea_range_sample_array(alea_state *state,
+                                    const alea_range_sampler *sampler,
+                                    uint64_t *const dst, const size_t dst_len) {
+  alea_range_fill(state, sampler, dst, dst_len);
+  return ALEA_RETURN_OK;
+}
+
+// Uniform sampling modulo a multi-limb modulus M, with 64-bit limbs stored
+// least significant first. The top limb is drawn first with as many bits as
+// the top limb of M has, and rejected right away if it exceeds it; only then
+// are the lower limbs drawn and the full value compared with M. A draw of
+// 1000+ bits is thus rejected almost always on a single word, and the
+// accepted values all go through the same branch-free comparison.
+
+// 1 if x < m, else 0, as the final borrow of x - m.
+inline static uint64_t alea_bigint_less(const uint64_t *x, const uint64_t *m,
+                                        const size_t num_limbs) {
+  uint64_t borrow = 0;
+  for (size_t k = 0; k < num_limbs; k++) {
+    const uint64_t d = x[k] - m[k];
+    borrow = (uint64_t)(x[k] < m[k]) | (uint64_t)(d < borrow);
+  }
+  return borrow;
+}
+
+inline static void alea_bigint_sample(alea_state *state, alea_bit_cursor *cur,
+                                      uint64_t *const dst, const uint64_t *m,
+                                      const size_t num_limbs,
+                                      const unsigned top_bits) {
+  const uint64_t m_top = m[num_limbs - 1];
+  for (;;) {
+    const uint64_t top = alea_bit_cursor_get(state, cur, top_bits);
+    if (top > m_top)
+      continue;
+    alea_get_random_uint64_array(state, dst, num_limbs - 1);
+    dst[num_limbs - 1] = top;
+    if (alea_bigint_less(dst, m, num_limbs))
+      return;
   }
+}
 
+alea_return alea_sample_uniform_mod_bigint(alea_state *state,
+                                           uint64_t *const dst,
+                                           const uint64_t *modulus,
+                                           const size_t num_limbs) {
+  assert(num_limbs >= 1 && modulus[num_limbs - 1] != 0);
+
+  alea_bigint_sample(state, alea_get_bit_cursor(state), dst, modulus,
+                     num_limbs, alea_bit_length(modulus[num_limbs - 1]));
   return ALEA_RETURN_OK;
 }
 
-alea_return alea_sample_hwt_int64_array(alea_state *state, int64_t *const dst,
-                                        const size_t dst_len, const int hwt) {
-  assert(hwt > 0);
+alea_return alea_sample_uniform_mod_bigint_array(alea_state *state,
+                                                 uint64_t *const dst,
+                                                 const size_t dst_len,
+                                                 const uint64_t *modulus,
+                                                 const size_t num_limbs) {
+  assert(num_limbs >= 1 && modulus[num_limbs - 1] != 0);
+
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  const unsigned top_bits = alea_bit_length(modulus[num_limbs - 1]);
+  for (size_t i = 0; i < dst_len; i++) {
+    alea_bigint_sample(state, cur, dst + i * num_limbs, modulus, num_limbs,
+                       top_bits);
+  }
+  return ALEA_RETURN_OK;
+}
+
+// By the CRT, a uniform value modulo the product of the moduli has
+// independent uniform residues, so each limb is filled on its own without
+// forming the product. A uniform residue stays uniform when multiplied by
+// 2^64 mod q, so the limbs serve either representation.
+alea_return alea_sample_uniform_rns(alea_state *state, uint64_t *const dst,
+                                    const size_t dst_len,
+                                    const uint64_t *moduli,
+                                    const size_t num_moduli) {
+  assert(num_moduli >= 1);
+
+  for (size_t l = 0; l < num_moduli; l++) {
+    assert(moduli[l] >= 2);
+    alea_range_sampler sampler;
+    alea_range_sampler_init(&sampler, moduli[l]);
+    alea_range_fill(state, &sampler, dst + l * dst_len, dst_len);
+  }
+  return ALEA_RETURN_OK;
+}
+
+// Fisher-Yates shuffle with batched draws (Brackett-Rozinsky and Lemire,
+// https://arxiv.org/abs/2408.06213). Steps i, i - 1, ..., i - k + 1 take their
+// indices from a single draw: with the draw in the top bits of x, the high word
+// of x * i is the first index, the low word times i - 1 gives the second, and
+// so on. The k indices are uniform once leftovers below 2^L mod bound are
+// rejected, where bound = i (i - 1) ... (i - k + 1) and L is the draw width.
+// k is as large as keeps bound below 2^56 and L = bit_length(bound) + 8, so a
+// batch is rejected with probability below 2^-8 and each index costs about
+// log2(i) bits. The swaps access memory at the drawn indices, so these
+// functions are not constant-time.
+#define ALEA_SHUFFLE_MAX_BATCH 6
+
+inline static unsigned alea_shuffle_batch_len(const uint64_t i) {
+  const unsigned k = i > (UINT64_C(1) << 28)   ? 1
+                     : i > (UINT64_C(1) << 18) ? 2
+                     : i > (UINT64_C(1) << 14) ? 3
+                     : i > (UINT64_C(1) << 11) ? 4
+                     : i > (UINT64_C(1) << 9)  ? 5
+                                               : ALEA_SHUFFLE_MAX_BATCH;
+  return k < i - 1 ? k : (unsigned)(i - 1);
+}
+
+inline static void alea_shuffle_batch(alea_state *state, alea_bit_cursor *cur,
+                                      const uint64_t i, const unsigned k,
+                                      uint64_t *const idx) {
+  uint64_t bound = i;
+  for (unsigned j = 1; j < k; j++) {
+    bound *= i - j;
+  }
+  const unsigned width = alea_bit_length(bound) + 8;
+  const unsigned L = width < 64 ? width : 64;
+  const unsigned shift = 64 - L;
+
+  uint64_t t = 0; // 2^L mod bound, computed on first need
+  for (;;) {
+    uint64_t lo = alea_bit_cursor_get(state, cur, L) << shift;
+    for (unsigned j = 0; j < k; j++) {
+      idx[j] = alea_mul_hi64(lo, i - j, &lo);
+    }
+    if (lo >= (bound << shift))
+      return;
+    if (t == 0) {
+      t = L == 64 ? (0 - bound) % bound : (UINT64_C(1) << L) % bound;
+    }
+    if (lo >= (t << shift))
+      return;
+  }
+}
+
+#define ALEA_DEFINE_SHUFFLE(TYPE, BITS)                                        \
+  inline static void alea_swap_u##BITS(TYPE *const arr, const uint64_t a,      \
+                                       const uint64_t b) {                     \
+    const TYPE tmp = arr[a];                                                   \
+    arr[a] = arr[b];                                                           \
+    arr[b] = tmp;                                                              \
+  }                                                                            \
+                                                                               \
+  alea_return alea_shuffle_u##BITS(alea_state *state, TYPE *const arr,         \
+                                   const size_t n) {                           \
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);                         \
+    uint64_t idx[ALEA_SHUFFLE_MAX_BATCH];                                      \
+    for (uint64_t i = n; i > 1;) {                                             \
+      const unsigned k = alea_shuffle_batch_len(i);                            \
+      alea_shuffle_batch(state, cur, i, k, idx);                               \
+      for (unsigned j = 0; j < k; j++) {                                       \
+        alea_swap_u##BITS(arr, i - 1 - j, idx[j]);                             \
+      }                                                                        \
+      i -= k;                                                                  \
+    }                                                                          \
+    return ALEA_RETURN_OK;                                                     \
+  }
+
+ALEA_DEFINE_SHUFFLE(uint32_t, 32)
+ALEA_DEFINE_SHUFFLE(uint64_t, 64)
+
+alea_return alea_random_permutation(alea_state *state, uint32_t *const perm,
+                                    const size_t n) {
+  assert(n <= (UINT64_C(1) << 32));
+
+  for (size_t i = 0; i < n; i++) {
+    perm[i] = (uint32_t)i;
+  }
+  return alea_shuffle_u32(state, perm, n);
+}
+
+// Constant-time shuffle: tag each entry with a random 64-bit key and sort the
+// keys with the sorting network, carrying the entries along. The keys are
+// drawn again if two of them are equal, which happens with probability below
+// n^2 / 2^65, so the permutation is exactly uniform. The retry only depends on
+// the keys, not on the entries.
+static void alea_shuffle_sort(alea_state *state, uint64_t *keys,
+                              uint64_t *vals, const size_t n) {
+  uint64_t same;
+  do {
+    alea_get_random_uint64_array(state, keys, n);
+    alea_ct_sort_uint64(keys, vals, n);
+    same = 0;
+    for (size_t i = 1; i < n; i++) {
+      const uint64_t d = keys[i] ^ keys[i - 1];
+      same |= ((d | (0 - d)) >> 63) ^ 1;
+    }
+  } while (same);
+}
+
+alea_return alea_shuffle_u64_ct(alea_state *state, uint64_t *const arr,
+                                const size_t n) {
+  if (n < 2)
+    return ALEA_RETURN_OK;
+
+  uint64_t *keys = malloc(n * sizeof(uint64_t));
+  if (keys == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
 
-  memset(dst, 0, dst_len * sizeof(int64_t));
+  alea_shuffle_sort(state, keys, arr, n);
+  safe_free(keys, n * sizeof(uint64_t));
+  return ALEA_RETURN_OK;
+}
 
-  int32_t *si = malloc(dst_len * sizeof(int32_t));
-  if (si == NULL) {
+alea_return alea_shuffle_u32_ct(alea_state *state, uint32_t *const arr,
+                                const size_t n) {
+  if (n < 2)
+    return ALEA_RETURN_OK;
+
+  // keys followed by the entries widened to 64 bits
+  uint64_t *keys = malloc(2 * n * sizeof(uint64_t));
+  if (keys == NULL)
     return ALEA_RETURN_BAD_MALLOC_FAILURE;
+  uint64_t *vals = keys + n;
+
+  for (size_t i = 0; i < n; i++) {
+    vals[i] = arr[i];
+  }
+  alea_shuffle_sort(state, keys, vals, n);
+  for (size_t i = 0; i < n; i++) {
+    arr[i] = (uint32_t)vals[i];
+  }
+
+  safe_free(keys, 2 * n * sizeof(uint64_t));
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_random_permutation_ct(alea_state *state, uint32_t *const perm,
+                                       const size_t n) {
+  assert(n <= (UINT64_C(1) << 32));
+
+  for (size_t i = 0; i < n; i++) {
+    perm[i] = (uint32_t)i;
+  }
+  return alea_shuffle_u32_ct(state, perm, n);
+}
+
+#if defined ALEA_HWT_SORT
+
+// Sorting backend (ALEA_HWT_SORT). Entry k of the key array gets the tag of
+// the k-th entry of a fixed pattern, hwt entries of +-1 followed by zeros, in
+// its low two bits and uniform random bits above them. Sorting the keys with a
+// sorting network applies a uniform random permutation to the pattern, so the
+// tags read back in order form the vector. The work depends only on
+// `dst_len`.
+//
+// Keys that agree in their 62 random bits would be ordered by their tags and
+// bias the permutation, so as in `alea_shuffle_sort` all keys are drawn again
+// when two neighbours agree after sorting. This happens with probability below
+// dst_len^2 / 2^63, and the check itself has no branches on the keys.
+#define ALEA_HWT_TAG_MASK UINT64_C(3)
+
+inline static void alea_hwt_sort_keys(alea_state *state, uint64_t *keys,
+                                      const size_t dst_len, const int hwt) {
+  assert(hwt > 0 && (size_t)hwt <= dst_len);
+
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  uint64_t same;
+  do {
+    alea_get_random_uint64_array(state, keys, dst_len);
+    // tag 0 is 0, tag 1 is 1 and tag 2 is -1
+    for (size_t i = 0; i < (size_t)hwt; i++) {
+      const uint64_t tag = 1 + alea_bit_cursor_get(state, cur, 1);
+      keys[i] = (keys[i] & ~ALEA_HWT_TAG_MASK) | tag;
+    }
+    for (size_t i = (size_t)hwt; i < dst_len; i++) {
+      keys[i] &= ~ALEA_HWT_TAG_MASK;
+    }
+    alea_ct_sort_uint64(keys, NULL, dst_len);
+
+    same = 0;
+    for (size_t i = 1; i < dst_len; i++) {
+      const uint64_t d = (keys[i] ^ keys[i - 1]) & ~ALEA_HWT_TAG_MASK;
+      same |= ((d | (0 - d)) >> 63) ^ 1;
+    }
+  } while (same);
+}
+
+inline static int32_t alea_hwt_key_value(const uint64_t key) {
+  const uint64_t tag = key & ALEA_HWT_TAG_MASK;
+  return (int32_t)(tag & 1) - (int32_t)(tag >> 1);
+}
+
+// Keys for the int32 and int8 variants; int64 entries hold the keys in place.
+size_t alea_hwt_workspace_size(const size_t dst_len) {
+  return dst_len * sizeof(uint64_t); // one key per entry
+}
+
+alea_return alea_sample_hwt_int64_array_workspace(alea_state *state,
+                                                  int64_t *const dst,
+                                                  const size_t dst_len,
+                                                  const int hwt,
+                                                  void *workspace) {
+  (void)workspace; // the keys are sorted in dst
+  return alea_sample_hwt_int64_array(state, dst, dst_len, hwt);
+}
+
+alea_return alea_sample_hwt_int32_array_workspace(alea_state *state,
+                                                  int32_t *const dst,
+                                                  const size_t dst_len,
+                                                  const int hwt,
+                                                  void *workspace) {
+  uint64_t *keys = (uint64_t *)workspace;
+  alea_hwt_sort_keys(state, keys, dst_len, hwt);
+  for (size_t i = 0; i < dst_len; i++) {
+    dst[i] = alea_hwt_key_value(keys[i]);
   }
-  alea_rejection_sampling_mod(state, si, dst_len);
+  memset(keys, 0, dst_len * sizeof(uint64_t));
+  return ALEA_RETURN_OK;
+}
 
-  int c0 = (int)dst_len - hwt;
-  int t0;
-  uint8_t rnd;
+alea_return alea_sample_hwt_int8_array_workspace(alea_state *state,
+                                                 int8_t *const dst,
+                                                 const size_t dst_len,
+                                                 const int hwt,
+                                                 void *workspace) {
+  uint64_t *keys = (uint64_t *)workspace;
+  alea_hwt_sort_keys(state, keys, dst_len, hwt);
   for (size_t i = 0; i < dst_len; i++) {
-    t0 = -(si[i] < c0); // (si[i] - c0 >= 0) ? 0 : -1
-    c0 += t0;
-    dst[i] = 1 + t0;
-    alea_get_random_bytes(state, &rnd, 1);
-    dst[i] = (-dst[i]) & (1 - ((rnd & 1) << 1));
+    dst[i] = (int8_t)alea_hwt_key_value(keys[i]);
   }
+  memset(keys, 0, dst_len * sizeof(uint64_t));
+  return ALEA_RETURN_OK;
+}
 
-  safe_free(si, dst_len * sizeof(int32_t));
+alea_return alea_sample_hwt_int64_array(alea_state *state, int64_t *const dst,
+                                        const size_t dst_len, const int hwt) {
+  // dst is large enough to hold the keys, and each key is replaced by its
+  // value in place.
+  uint64_t *keys = (uint64_t *)dst;
+  alea_hwt_sort_keys(state, keys, dst_len, hwt);
+  for (size_t i = 0; i < dst_len; i++) {
+    dst[i] = alea_hwt_key_value(keys[i]);
+  }
   return ALEA_RETURN_OK;
 }
 
 alea_return alea_sample_hwt_int32_array(alea_state *state, int32_t *const dst,
                                         const size_t dst_len, const int hwt) {
-  assert(hwt > 0);
+  const size_t workspace_len = alea_hwt_workspace_size(dst_len);
+  void *workspace = malloc(workspace_len);
+  if (workspace == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
 
-  memset(dst, 0, dst_len * sizeof(int32_t));
+  alea_sample_hwt_int32_array_workspace(state, dst, dst_len, hwt, workspace);
+  free(workspace); // cleared by the workspace variant
+  return ALEA_RETURN_OK;
+}
 
-  int32_t *si = malloc(dst_len * sizeof(int32_t));
-  if (si == NULL) {
+alea_return alea_sample_hwt_int8_array(alea_state *state, int8_t *const dst,
+                                       const size_t dst_len, const int hwt) {
+  const size_t workspace_len = alea_hwt_workspace_size(dst_len);
+  void *workspace = malloc(workspace_len);
+  if (workspace == NULL)
     return ALEA_RETURN_BAD_MALLOC_FAILURE;
+
+  alea_sample_hwt_int8_array_workspace(state, dst, dst_len, hwt, workspace);
+  free(workspace); // cleared by the workspace variant
+  return ALEA_RETURN_OK;
+}
+
+#else
+
+// See the paper: Efficient isochronous fixed-weight sampling with applications
+// to NTRU (https://eprint.iacr.org/2024/548) for more details on fixed-weight
+// sampling.
+//
+// The vector is produced one position at a time. Position i is zero with
+// probability zeros / (n - i), where `zeros` counts the zeros still to place:
+// a uniform s_i in [0, n - i) is drawn and the position is zero iff
+// s_i < zeros. Drawing and deciding are fused, so no per-position array is
+// kept.
+typedef struct {
+  uint64_t n;     // vector length
+  uint64_t i;     // next position
+  uint64_t zeros; // zeros left to place
+  unsigned L;     // bits per draw
+} alea_hwt_stream;
+
+inline static void alea_hwt_stream_init(alea_hwt_stream *hs,
+                                        const size_t dst_len, const int hwt) {
+  assert(hwt > 0 && (size_t)hwt <= dst_len);
+
+  hs->n = (uint64_t)dst_len;
+  hs->i = 0;
+  hs->zeros = (uint64_t)dst_len - (uint64_t)hwt;
+  // Choosing L involves a trade-off between the cost of generating random
+  // numbers and the rate of sample rejections. A draw is rejected with
+  // probability (2^L mod s) / 2^L < n / 2^L, so L = bit_length(n) + 13 keeps
+  // the rejection rate below 2^-13 for every n, at a cost of L bits per
+  // position. Rejections are the only source of timing variation.
+  const unsigned L = alea_bit_length(hs->n) + 13;
+  hs->L = L < 64 ? L : 64;
+}
+
+// Returns the next entry of the vector: -1, 0 or 1.
+inline static int32_t alea_hwt_stream_next(alea_state *state,
+                                           alea_bit_cursor *cur,
+                                           alea_hwt_stream *hs) {
+  const uint64_t s = hs->n - hs->i;
+  // 2^L mod s, computed for every position whether or not it is needed
+  const uint64_t t = hs->L == 64 ? (0 - s) % s : (UINT64_C(1) << hs->L) % s;
+  const unsigned shift = 64 - hs->L;
+
+  // Lemire's method at L bits: with the draw in the top L bits of x, the high
+  // word of x * s is floor(rnd * s / 2^L) and the low word is
+  // (rnd * s mod 2^L) << (64 - L).
+  uint64_t si, lo;
+  do {
+    const uint64_t x = alea_bit_cursor_get(state, cur, hs->L) << shift;
+    si = alea_mul_hi64(x, s, &lo);
+  } while (lo < (t << shift));
+
+  const uint64_t zero = si < hs->zeros;
+  hs->zeros -= zero;
+  hs->i++;
+
+  const int32_t nonzero = (int32_t)(1 - zero);
+  const int32_t bit = (int32_t)alea_bit_cursor_get(state, cur, 1);
+  return (-nonzero) & (1 - (bit << 1));
+}
+
+size_t alea_hwt_workspace_size(const size_t dst_len) {
+  (void)dst_len;
+  return 0; // the positions are streamed
+}
+
+alea_return alea_sample_hwt_int64_array_workspace(alea_state *state,
+                                                  int64_t *const dst,
+                                                  const size_t dst_len,
+                                                  const int hwt,
+                                                  void *workspace) {
+  (void)workspace;
+  return alea_sample_hwt_int64_array(state, dst, dst_len, hwt);
+}
+
+alea_return alea_sample_hwt_int32_array_workspace(alea_state *state,
+                                                  int32_t *const dst,
+                                                  const size_t dst_len,
+                                                  const int hwt,
+                                                  void *workspace) {
+  (void)workspace;
+  return alea_sample_hwt_int32_array(state, dst, dst_len, hwt);
+}
+
+alea_return alea_sample_hwt_int8_array_workspace(alea_state *state,
+                                                 int8_t *const dst,
+                                                 const size_t dst_len,
+                                                 const int hwt,
+                                                 void *workspace) {
+  (void)workspace;
+  return alea_sample_hwt_int8_array(state, dst, dst_len, hwt);
+}
+
+alea_return alea_sample_hwt_int64_array(alea_state *state, int64_t *const dst,
+                                        const size_t dst_len, const int hwt) {
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_hwt_stream hs;
+  alea_hwt_stream_init(&hs, dst_len, hwt);
+
+  for (size_t i = 0; i < dst_len; i++) {
+    dst[i] = alea_hwt_stream_next(state, cur, &hs);
   }
-  alea_rejection_sampling_mod(state, si, dst_len);
 
-  int c0 = (int)dst_len - hwt;
-  int t0;
-  uint8_t rnd;
+  memset(&hs, 0, sizeof(hs));
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_sample_hwt_int32_array(alea_state *state, int32_t *const dst,
+                                        const size_t dst_len, const int hwt) {
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_hwt_stream hs;
+  alea_hwt_stream_init(&hs, dst_len, hwt);
+
   for (size_t i = 0; i < dst_len; i++) {
-    t0 = -(si[i] < c0); // (si[i] - c0 >= 0) ? 0 : -1
-    c0 += t0;
-    dst[i] = 1 + t0;
-    alea_get_random_bytes(state, &rnd, 1);
-    dst[i] = (-dst[i]) & (1 - ((rnd & 1) << 1));
+    dst[i] = alea_hwt_stream_next(state, cur, &hs);
   }
 
-  safe_free(si, dst_len * sizeof(int32_t));
+  memset(&hs, 0, sizeof(hs));
   return ALEA_RETURN_OK;
 }
 
 alea_return alea_sample_hwt_int8_array(alea_state *state, int8_t *const dst,
                                        const size_t dst_len, const int hwt) {
-  assert(hwt > 0);
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_hwt_stream hs;
+  alea_hwt_stream_init(&hs, dst_len, hwt);
 
-  memset(dst, 0, dst_len * sizeof(int8_t));
+  for (size_t i = 0; i < dst_len; i++) {
+    dst[i] = (int8_t)alea_hwt_stream_next(state, cur, &hs);
+  }
 
-  int32_t *si = malloc(dst_len * sizeof(int32_t));
-  if (si == NULL) {
-    return ALEA_RETURN_BAD_MALLOC_FAILURE;
+  memset(&hs, 0, sizeof(hs));
+  return ALEA_RETURN_OK;
+}
+
+#endif // ALEA_HWT_SORT
+
+// Floyd's algorithm picks the positions: for j = n - hwt, ..., n - 1, draw t
+// from [0, j] and take t, or j if t was already taken. Every hwt-subset comes
+// out with the same probability. The membership test scans all earlier picks
+// without branching and the positions are sorted with a sorting network, so
+// the running time depends on `hwt` and not on the positions. The work is
+// quadratic in `hwt`.
+alea_return alea_sample_hwt_sparse(alea_state *state, const size_t dst_len,
+                                   const int hwt, uint32_t *const idx,
+                                   int8_t *const sign) {
+  assert(hwt > 0 && (size_t)hwt <= dst_len);
+  assert(dst_len <= UINT64_C(1) << 32);
+
+  const size_t h = (size_t)hwt;
+  for (size_t k = 0; k < h; k++) {
+    const uint64_t j = (uint64_t)(dst_len - h + k);
+    const uint64_t t =
+        j == 0 ? 0 : alea_get_random_uint64_in_range(state, j + 1);
+
+    uint64_t taken = 0;
+    for (size_t m = 0; m < k; m++) {
+      taken |= ((uint64_t)(idx[m] ^ t) - 1) >> 63; // idx[m] == t
+    }
+    idx[k] = (uint32_t)(t ^ ((t ^ j) & (0 - taken)));
   }
-  alea_rejection_sampling_mod(state, si, dst_len);
 
-  int c0 = (int)dst_len - hwt;
-  int t0;
-  uint8_t rnd;
-  for (size_t i = 0; i < dst_len; i++) {
-    t0 = -(si[i] < c0); // (si[i] - c0 >= 0) ? 0 : -1
-    c0 += t0;
-    dst[i] = (int8_t)(1 + t0);
-    alea_get_random_bytes(state, &rnd, 1);
-    dst[i] = (-dst[i]) & (1 - ((rnd & 1) << 1));
+  alea_ct_sort_uint32(idx, NULL, h);
+
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  for (size_t k = 0; k < h; k++) {
+    sign[k] = (int8_t)(1 - 2 * (int)alea_bit_cursor_get(state, cur, 1));
   }
 
-  safe_free(si, dst_len * sizeof(int32_t));
   return ALEA_RETURN_OK;
 }
 
-#ifndef __has_builtin
-#define __has_builtin(arg) 0
-#endif
+// Uses the hardware instruction where the target is known to have one. The
+// portable fallback is branch-free and avoids the table lookups that a compiler
+// runtime popcount may use, so it is safe on secret data.
 inline static int32_t alea_popcount(uint64_t x) {
-#if __has_builtin(__builtin_popcountll)
+#if __has_builtin(__builtin_popcountll) &&                                     \
+    (defined(__POPCNT__) || defined(__aarch64__))
   return __builtin_popcountll(x);
 #elif defined(_MSC_VER)
   return (int32_t)__popcnt64(x);
 #else
-#define BITWIDTH sizeof(uint64_t) * 8 // in bits
-  int32_t count = 0;
-  for (int i = 0; i < BITWIDTH; i++) {
-    count += x & 1;
-    x >>= 1;
-  }
-  return count;
-#undef BITWIDTH
+  x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+  x = (x & UINT64_C(0x3333333333333333)) +
+      ((x >> 2) & UINT64_C(0x3333333333333333));
+  x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+  return (int32_t)((x * UINT64_C(0x0101010101010101)) >> 56);
 #endif
 }
 
+// Signed samplers that write narrower integers produce their output in blocks
+// of ALEA_BLOCK_LEN int64 values first. The block stays in L1, so narrowing it
+// into the caller's array is cheap next to generating the randomness.
+#define ALEA_BLOCK_LEN 256
+
+// Narrowing copies for the block samplers, one per output width. Each is a
+// plain loop over a block in L1, which the compiler can vectorize into packing
+// stores. A new width only needs a line here and one ALEA_DEFINE_*_ARRAY line
+// per family.
+#define ALEA_DEFINE_NARROW(TYPE, WIDTH)                                        \
+  inline static void alea_narrow_##WIDTH(TYPE *const dst,                      \
+                                         const int64_t *const blk,             \
+                                         const size_t len) {                   \
+    for (size_t j = 0; j < len; j++) {                                         \
+      dst[j] = (TYPE)blk[j];                                                   \
+    }                                                                          \
+  }
+
+ALEA_DEFINE_NARROW(int32_t, int32)
+ALEA_DEFINE_NARROW(int16_t, int16)
+ALEA_DEFINE_NARROW(int8_t, int8)
+
+// All CBD kernels consume the stream the same way: coefficient i takes the
+// next 2 * eta bits of the bit cursor, and is the popcount of the first eta of
+// them minus the popcount of the second eta. No bits are skipped between
+// coefficients, so the specialized kernels below only differ from the generic
+// one in how many coefficients they derive per word.
+
+// eta = 2: add neighbouring bits pairwise, so each 4-bit group of a word
+// holds the two 2-bit popcounts of one coefficient. 16 coefficients per word.
+inline static void alea_cbd2_word(const uint64_t w, int64_t *const dst,
+                                  const size_t n) {
+  const uint64_t d = (w & UINT64_C(0x5555555555555555)) +
+                     ((w >> 1) & UINT64_C(0x5555555555555555));
+  for (size_t j = 0; j < n; j++) {
+    dst[j] = (int64_t)((d >> (4 * j)) & 3) - (int64_t)((d >> (4 * j + 2)) & 3);
+  }
+}
+
+static void alea_cbd2(alea_state *state, alea_bit_cursor *cur,
+                      int64_t *const dst, const size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    alea_cbd2_word(alea_bit_cursor_get(state, cur, 64), dst + i, 16);
+  }
+  if (i < len) {
+    const size_t rem = len - i;
+    alea_cbd2_word(alea_bit_cursor_get(state, cur, (unsigned)(4 * rem)),
+                   dst + i, rem);
+  }
+}
+
+// eta = 3: sum each 3-bit group of the low 60 bits, so each 6-bit group holds
+// the two 3-bit popcounts of one coefficient. 10 coefficients per 60 bits.
+inline static void alea_cbd3_word(const uint64_t w, int64_t *const dst,
+                                  const size_t n) {
+  const uint64_t m = UINT64_C(0x0249249249249249);
+  const uint64_t d = (w & m) + ((w >> 1) & m) + ((w >> 2) & m);
+  for (size_t j = 0; j < n; j++) {
+    dst[j] = (int64_t)((d >> (6 * j)) & 7) - (int64_t)((d >> (6 * j + 3)) & 7);
+  }
+}
+
+static void alea_cbd3(alea_state *state, alea_bit_cursor *cur,
+                      int64_t *const dst, const size_t len) {
+  size_t i = 0;
+  for (; i + 10 <= len; i += 10) {
+    alea_cbd3_word(alea_bit_cursor_get(state, cur, 60), dst + i, 10);
+  }
+  if (i < len) {
+    const size_t rem = len - i;
+    alea_cbd3_word(alea_bit_cursor_get(state, cur, (unsigned)(6 * rem)),
+                   dst + i, rem);
+  }
+}
+
+// Generic path for 1 <= eta <= 64. Inlined with a constant `eta`, the masks and
+// draw widths fold into immediates.
+inline static void alea_cbd_generic(alea_state *state, alea_bit_cursor *cur,
+                                    int64_t *const dst, const size_t len,
+                                    const unsigned eta) {
+  if (eta <= 32) {
+    const uint64_t mask = ~UINT64_C(0) >> (64 - eta);
+    for (size_t i = 0; i < len; i++) {
+      const uint64_t x = alea_bit_cursor_get(state, cur, 2 * eta);
+      dst[i] = alea_popcount(x & mask) - alea_popcount(x >> eta);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    const uint64_t a = alea_bit_cursor_get(state, cur, eta);
+    const uint64_t b = alea_bit_cursor_get(state, cur, eta);
+    dst[i] = alea_popcount(a) - alea_popcount(b);
+  }
+}
+
+// Wide path for eta > 64: each half of a coefficient is popcounted one 64-bit
+// word at a time. The loop bounds only depend on eta, so the running time is
+// independent of the sampled bits.
+static void alea_cbd_wide(alea_state *state, alea_bit_cursor *cur,
+                          int64_t *const dst, const size_t len,
+                          const size_t eta) {
+  for (size_t i = 0; i < len; i++) {
+    int64_t c = 0;
+    for (size_t left = eta; left > 0;) {
+      const unsigned take = left < 64 ? (unsigned)left : 64;
+      c += alea_popcount(alea_bit_cursor_get(state, cur, take));
+      left -= take;
+    }
+    for (size_t left = eta; left > 0;) {
+      const unsigned take = left < 64 ? (unsigned)left : 64;
+      c -= alea_popcount(alea_bit_cursor_get(state, cur, take));
+      left -= take;
+    }
+    dst[i] = c;
+  }
+}
+
+static void alea_cbd_kernel(alea_state *state, alea_bit_cursor *cur,
+                            int64_t *const dst, const size_t len,
+                            const size_t cbd_num_flips) {
+  switch (cbd_num_flips) {
+  case 0:
+    memset(dst, 0, len * sizeof(int64_t));
+    break;
+  case 2:
+    alea_cbd2(state, cur, dst, len);
+    break;
+  case 3:
+    alea_cbd3(state, cur, dst, len);
+    break;
+  case 21:
+    alea_cbd_generic(state, cur, dst, len, 21);
+    break;
+  default:
+    if (cbd_num_flips <= 64) {
+      alea_cbd_generic(state, cur, dst, len, (unsigned)cbd_num_flips);
+    } else {
+      alea_cbd_wide(state, cur, dst, len, cbd_num_flips);
+    }
+    break;
+  }
+}
+
 alea_return alea_sample_cbd_int64_array(alea_state *state, int64_t *const dst,
                                         const size_t dst_len,
                                         const size_t cbd_num_flips) {
-  const uint64_t CBD_MASK = (UINT64_C(1) << cbd_num_flips) - 1;
-  const uint64_t CBD_NUM_FLIPS_BYTES =
-      (cbd_num_flips + 7) / 8; // Round up to nearest byte
-  uint64_t rnd1 = 0, rnd2 = 0;
-  for (size_t i = 0; i < dst_len; i++) {
-    alea_get_random_bytes(state, (uint8_t *)&rnd1, CBD_NUM_FLIPS_BYTES);
-    alea_get_random_bytes(state, (uint8_t *)&rnd2, CBD_NUM_FLIPS_BYTES);
-    rnd1 &= CBD_MASK;
-    rnd2 &= CBD_MASK;
-    dst[i] = alea_popcount(rnd1) - alea_popcount(rnd2);
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+
+  alea_cbd_kernel(state, cur, dst, dst_len, cbd_num_flips);
+  return ALEA_RETURN_OK;
+}
+
+// Defines alea_sample_cbd_<WIDTH>_array on top of the int64 kernel. Samples
+// lie in [-cbd_num_flips, cbd_num_flips], which must fit in TYPE.
+#define ALEA_DEFINE_CBD_ARRAY(TYPE, WIDTH, MAX)                                \
+  alea_return alea_sample_cbd_##WIDTH##_array(                                 \
+      alea_state *state, TYPE *const dst, const size_t dst_len,                \
+      const size_t cbd_num_flips) {                                            \
+    assert(cbd_num_flips <= (size_t)MAX);                                      \
+    int64_t blk[ALEA_BLOCK_LEN];                                               \
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);                         \
+                                                                               \
+    for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {                     \
+      const size_t len =                                                       \
+          dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;         \
+      alea_cbd_kernel(state, cur, blk, len, cbd_num_flips);                    \
+      alea_narrow_##WIDTH(dst + i, blk, len);                                  \
+    }                                                                          \
+                                                                               \
+    memset(blk, 0, sizeof(blk));                                               \
+    return ALEA_RETURN_OK;                                                     \
+  }
+
+ALEA_DEFINE_CBD_ARRAY(int32_t, int32, INT32_MAX)
+ALEA_DEFINE_CBD_ARRAY(int16_t, int16, INT16_MAX)
+ALEA_DEFINE_CBD_ARRAY(int8_t, int8, INT8_MAX)
+
+// Ternary distribution ZO(rho). rho is rounded to threshold / 2^width with
+// width <= 32 as small as possible, and each coefficient takes the next
+// width + 1 bits of the bit cursor: the low bit is the sign, and the
+// coefficient is nonzero iff the other width bits are below threshold. As
+// many coefficients as fit are derived from each draw of up to 64 bits, e.g.
+// 32 per word for rho = 1/2.
+//
+// rho = 2/3 (uniform ternary) is not dyadic, so it is sampled from base-3
+// digits instead: a byte below 3^5 = 243 gives five uniform digits, and bytes
+// 243 to 255 are rejected (probability 13/256). Rejections are the only source
+// of timing variation.
+typedef struct {
+  int uniform;
+  unsigned width;
+  uint64_t threshold;
+} alea_ternary_params;
+
+inline static void alea_ternary_params_init(alea_ternary_params *tp,
+                                            const double rho) {
+  assert(rho > 0 && rho <= 1);
+
+  tp->uniform = rho == ALEA_TERNARY_UNIFORM;
+  tp->width = 32;
+  tp->threshold = (uint64_t)(ldexp(rho, 32) + 0.5);
+  assert(tp->threshold != 0); // rho >= 2^-33
+  while (tp->width > 0 && (tp->threshold & 1) == 0) {
+    tp->threshold >>= 1;
+    tp->width--;
+  }
+}
+
+// Inlined with a constant `width` and `threshold`, the shifts and the
+// comparison fold into immediates.
+inline static void alea_ternary_zo(alea_state *state, alea_bit_cursor *cur,
+                                   int64_t *const dst, const size_t len,
+                                   const unsigned width,
+                                   const uint64_t threshold) {
+  const unsigned bits = width + 1;
+  const size_t per = 64 / bits;
+  const uint64_t mask = ~UINT64_C(0) >> (64 - bits);
+
+  for (size_t i = 0; i < len; i += per) {
+    const size_t n = len - i < per ? len - i : per;
+    uint64_t w = alea_bit_cursor_get(state, cur, (unsigned)(n * bits));
+    for (size_t j = 0; j < n; j++) {
+      const uint64_t field = w & mask;
+      // field >> 1 and threshold are below 2^33, so the difference is
+      // negative iff field >> 1 < threshold
+      const int64_t nonzero = (int64_t)(((field >> 1) - threshold) >> 63);
+      const int64_t sign = (int64_t)(field & 1);
+      dst[i + j] = (-nonzero) & (1 - 2 * sign);
+      w >>= bits;
+    }
+  }
+}
+
+static void alea_ternary_uniform(alea_state *state, alea_bit_cursor *cur,
+                                 int64_t *const dst, const size_t len) {
+  for (size_t i = 0; i < len; i += 5) {
+    uint64_t b;
+    do {
+      b = alea_bit_cursor_get(state, cur, 8);
+    } while (b >= 243);
+
+    const size_t n = len - i < 5 ? len - i : 5;
+    for (size_t j = 0; j < n; j++) {
+      dst[i + j] = (int64_t)(b % 3) - 1;
+      b /= 3;
+    }
+  }
+}
+
+static void alea_ternary_kernel(alea_state *state, alea_bit_cursor *cur,
+                                int64_t *const dst, const size_t len,
+                                const alea_ternary_params *tp) {
+  if (tp->uniform) {
+    alea_ternary_uniform(state, cur, dst, len);
+  } else if (tp->width == 1) {
+    alea_ternary_zo(state, cur, dst, len, 1, 1); // rho = 1/2
+  } else {
+    alea_ternary_zo(state, cur, dst, len, tp->width, tp->threshold);
   }
+}
+
+alea_return alea_sample_ternary_int64_array(alea_state *state,
+                                            int64_t *const dst,
+                                            const size_t dst_len,
+                                            const double rho) {
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_ternary_params tp;
+  alea_ternary_params_init(&tp, rho);
 
+  alea_ternary_kernel(state, cur, dst, dst_len, &tp);
   return ALEA_RETURN_OK;
 }
 
-alea_return alea_sample_cbd_int32_array(alea_state *state, int32_t *const dst,
-                                        const size_t dst_len,
-                                        const size_t cbd_num_flips) {
-  const uint64_t CBD_MASK = (UINT64_C(1) << cbd_num_flips) - 1;
-  const uint64_t CBD_NUM_FLIPS_BYTES =
-      (cbd_num_flips + 7) / 8; // Round up to nearest byte
-  uint64_t rnd1 = 0, rnd2 = 0;
-  for (size_t i = 0; i < dst_len; i++) {
-    alea_get_random_bytes(state, (uint8_t *)&rnd1, CBD_NUM_FLIPS_BYTES);
-    alea_get_random_bytes(state, (uint8_t *)&rnd2, CBD_NUM_FLIPS_BYTES);
-    rnd1 &= CBD_MASK;
-    rnd2 &= CBD_MASK;
-    dst[i] = alea_popcount(rnd1) - alea_popcount(rnd2);
+// Defines alea_sample_ternary_<WIDTH>_array on top of the int64 kernel.
+#define ALEA_DEFINE_TERNARY_ARRAY(TYPE, WIDTH)                                 \
+  alea_return alea_sample_ternary_##WIDTH##_array(                             \
+      alea_state *state, TYPE *const dst, const size_t dst_len,                \
+      const double rho) {                                                      \
+    int64_t blk[ALEA_BLOCK_LEN];                                               \
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);                         \
+    alea_ternary_params tp;                                                    \
+    alea_ternary_params_init(&tp, rho);                                        \
+                                                                               \
+    for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {                     \
+      const size_t len =                                                       \
+          dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;         \
+      alea_ternary_kernel(state, cur, blk, len, &tp);                          \
+      alea_narrow_##WIDTH(dst + i, blk, len);                                  \
+    }                                                                          \
+                                                                               \
+    memset(blk, 0, sizeof(blk));                                               \
+    return ALEA_RETURN_OK;                                                     \
+  }
+
+ALEA_DEFINE_TERNARY_ARRAY(int32_t, int32)
+ALEA_DEFINE_TERNARY_ARRAY(int16_t, int16)
+ALEA_DEFINE_TERNARY_ARRAY(int8_t, int8)
+
+alea_return alea_sample_ternary_packed(alea_state *state, uint8_t *const dst,
+                                       const size_t dst_len, const double rho) {
+  int64_t blk[ALEA_BLOCK_LEN]; // a multiple of 4, so bytes never straddle
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_ternary_params tp;
+  alea_ternary_params_init(&tp, rho);
+
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_ternary_kernel(state, cur, blk, len, &tp);
+    for (size_t j = 0; j < len; j += 4) {
+      uint8_t byte = 0;
+      for (size_t k = 0; k < 4 && j + k < len; k++) {
+        byte |= (uint8_t)((uint64_t)(blk[j + k] & 3) << (2 * k));
+      }
+      dst[(i + j) / 4] = byte;
+    }
+  }
+
+  memset(blk, 0, sizeof(blk));
+  return ALEA_RETURN_OK;
+}
+
+// Bernoulli(p / 2^precision), 64 samples at a time. Word t of a draw holds bit
+// t of the precision-bit uniform u of each of the 64 samples, so [u < p] is a
+// bitsliced comparison like the one in src/codegen/dgauss-gen.c: from the
+// least significant bit up, a set bit of p makes u smaller wherever u has a 0
+// and defers to the lower bits otherwise, and a clear bit makes u larger
+// wherever u has a 1. The bits of p are expanded to masks instead of selecting
+// the operation, so the running time depends only on the output length and
+// the precision. Each sample costs `precision` random bits.
+inline static uint64_t alea_bernoulli_word(alea_state *state, uint64_t *const r,
+                                           const uint64_t p,
+                                           const unsigned precision) {
+  uint64_t lt = 0;
+  alea_get_random_uint64_array(state, r, precision);
+  for (unsigned t = 0; t < precision; t++) {
+    const uint64_t m = 0 - ((p >> t) & 1);
+    const uint64_t nb = ~r[t];
+    lt = (nb & lt) | (m & (nb | lt));
+  }
+  return lt;
+}
+
+alea_return alea_sample_bernoulli_bits_array(alea_state *state,
+                                             uint8_t *const dst,
+                                             const size_t dst_len,
+                                             const uint64_t p,
+                                             const unsigned precision) {
+  assert(precision >= 1 && precision <= 64);
+  assert(precision == 64 || (p >> precision) == 0);
+
+  uint64_t r[64];
+  for (size_t i = 0; i < dst_len; i += 64) {
+    const size_t len = dst_len - i < 64 ? dst_len - i : 64;
+    const uint64_t w = alea_bernoulli_word(state, r, p, precision) &
+                       (~UINT64_C(0) >> (64 - len));
+    for (size_t j = 0; j < len; j += 8) {
+      dst[(i + j) / 8] = (uint8_t)(w >> j);
+    }
+  }
+
+  memset(r, 0, sizeof(r));
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_sample_bernoulli_u8_array(alea_state *state,
+                                           uint8_t *const dst,
+                                           const size_t dst_len,
+                                           const uint64_t p,
+                                           const unsigned precision) {
+  assert(precision >= 1 && precision <= 64);
+  assert(precision == 64 || (p >> precision) == 0);
+
+  uint64_t r[64];
+  for (size_t i = 0; i < dst_len; i += 64) {
+    const size_t len = dst_len - i < 64 ? dst_len - i : 64;
+    const uint64_t w = alea_bernoulli_word(state, r, p, precision);
+    for (size_t j = 0; j < len; j++) {
+      dst[i + j] = (uint8_t)((w >> j) & 1);
+    }
   }
 
+  memset(r, 0, sizeof(r));
   return ALEA_RETURN_OK;
 }
 
-#define ALEA_TWO_PI 6.28318530717958647692
+// Box-Muller transform with branch-free polynomial approximations in place of
+// libm's log, cos, sin and llround. Every pair runs the same instruction
+// sequence, and a block of pairs is computed in one loop without calls, so the
+// compiler can vectorize it. The approximations are accurate to a few ulps,
+// far below the rounding to integers; the libm formulation is kept as the
+// reference in lowlevel-test.
+
+#define ALEA_LN2_HI 6.93147180369123816490e-01
+#define ALEA_LN2_LO 1.90821492927058770002e-10
+#define ALEA_SQRT2 1.41421356237309504880
+#define ALEA_PI_2 1.57079632679489661923
+
+// Natural logarithm of a positive normal double.
+inline static double alea_log(const double x) {
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+
+  // x = 2^e * m with m in [1, 2), then m is moved into [sqrt(1/2), sqrt(2)).
+  double e = (double)(int64_t)(bits >> 52) - 1023.0;
+  bits = (bits & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FF0000000000000);
+  double m;
+  memcpy(&m, &bits, sizeof(m));
+  const int big = m > ALEA_SQRT2;
+  m = big ? m * 0.5 : m;
+  e = big ? e + 1.0 : e;
+
+  // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.1716. The series
+  // is truncated after s^21, where the remainder is below 2^-60.
+  const double s = (m - 1.0) / (m + 1.0);
+  const double z = s * s;
+  double p = 1.0 / 21;
+  p = p * z + 1.0 / 19;
+  p = p * z + 1.0 / 17;
+  p = p * z + 1.0 / 15;
+  p = p * z + 1.0 / 13;
+  p = p * z + 1.0 / 11;
+  p = p * z + 1.0 / 9;
+  p = p * z + 1.0 / 7;
+  p = p * z + 1.0 / 5;
+  p = p * z + 1.0 / 3;
+  const double log_m = 2.0 * s + 2.0 * s * z * p;
+
+  return e * ALEA_LN2_HI + (log_m + e * ALEA_LN2_LO);
+}
+
+// cos and sin of 2 pi * a / 2^64. The top bits of the angle select a quadrant
+// exactly, and the remaining fraction is at most pi/4 in magnitude, where
+// Taylor polynomials up to x^17 (sin) and x^18 (cos) are accurate to 2^-60.
+inline static void alea_sincos_turn64(const uint64_t a, double *const c,
+                                      double *const s) {
+  const uint64_t shifted = a + (UINT64_C(1) << 61);
+  const uint64_t q = shifted >> 62;
+  const int64_t f = (int64_t)(shifted & UINT64_C(0x3FFFFFFFFFFFFFFF)) -
+                    (INT64_C(1) << 61);
+  const double x = (double)f * (ALEA_PI_2 / 4611686018427387904.0); // 2^62
+  const double z = x * x;
+
+  double ps = 1.0 / 355687428096000.0; // 1 / 17!
+  ps = ps * z - 1.0 / 1307674368000.0;
+  ps = ps * z + 1.0 / 6227020800.0;
+  ps = ps * z - 1.0 / 39916800.0;
+  ps = ps * z + 1.0 / 362880.0;
+  ps = ps * z - 1.0 / 5040.0;
+  ps = ps * z + 1.0 / 120.0;
+  ps = ps * z - 1.0 / 6.0;
+  const double sx = x + x * z * ps;
+
+  double pc = 1.0 / 6402373705728000.0; // 1 / 18!
+  pc = pc * z - 1.0 / 20922789888000.0;
+  pc = pc * z + 1.0 / 87178291200.0;
+  pc = pc * z - 1.0 / 479001600.0;
+  pc = pc * z + 1.0 / 3628800.0;
+  pc = pc * z - 1.0 / 40320.0;
+  pc = pc * z + 1.0 / 720.0;
+  pc = pc * z - 1.0 / 24.0;
+  pc = pc * z + 0.5;
+  const double cx = 1.0 - z * pc;
+
+  // Rotate by q quarter turns.
+  const double cr = (q & 1) ? sx : cx;
+  const double sr = (q & 1) ? cx : sx;
+  *c = ((q + 1) & 2) ? -cr : cr;
+  *s = (q & 2) ? -sr : sr;
+}
+
+// cos and sin of 2 pi * a / 2^32, with the same results as the 64-bit angle
+// a * 2^32: the fraction converts exactly either way.
+inline static void alea_sincos_turn32(const uint32_t a, double *const c,
+                                      double *const s) {
+  alea_sincos_turn64((uint64_t)a << 32, c, s);
+}
+
+// Round half away from zero, like llround, for |v| < 2^52.
+inline static int64_t alea_round(const double v) {
+  const int64_t t = (int64_t)v;
+  const double frac = v - (double)t;
+  return t + (frac >= 0.5) - (frac <= -0.5);
+}
+
+static void alea_gaussian_block(const uint64_t *const rnd, int64_t *const dst,
+                                const size_t num_pairs, const double stdev) {
+  for (size_t i = 0; i < num_pairs; i++) {
+    const uint64_t rn1 = rnd[i] >> 32;
+    const uint64_t rn2 = rnd[i] & UINT64_C(0xFFFFFFFF);
+    const double r2 = ((double)rn2 + 1.0) / 4294967296.; // 2^32 = 4294967296
+    const double rr = sqrt(-2.0 * alea_log(r2)) * stdev;
+    double c, s;
+    alea_sincos_turn32((uint32_t)rn1, &c, &s);
+
+    dst[2 * i] = alea_round(rr * c);
+    dst[2 * i + 1] = alea_round(rr * s);
+  }
+}
 
 alea_return alea_sample_gaussian_int64_array(alea_state *state,
                                              int64_t *const dst,
@@ -338,45 +1429,694 @@ alea_return alea_sample_gaussian_int64_array(alea_state *state,
                                              const double stdev) {
   assert(dst_len % 2 == 0);
 
-  for (size_t i = 0; i < dst_len; i += 2) {
-    const uint64_t rnd = alea_get_random_uint64(state);
+  uint64_t rnd[ALEA_BLOCK_LEN / 2];
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_get_random_bytes(state, (uint8_t *)rnd, len / 2 * sizeof(uint64_t));
+    alea_gaussian_block(rnd, dst + i, len / 2, stdev);
+  }
+
+  memset(rnd, 0, sizeof(rnd));
+  return ALEA_RETURN_OK;
+}
+
+// Defines alea_sample_gaussian_<WIDTH>_array on top of the block transform.
+#define ALEA_DEFINE_GAUSSIAN_ARRAY(TYPE, WIDTH)                                \
+  alea_return alea_sample_gaussian_##WIDTH##_array(                            \
+      alea_state *state, TYPE *const dst, const size_t dst_len,                \
+      const double stdev) {                                                    \
+    assert(dst_len % 2 == 0);                                                  \
+                                                                               \
+    uint64_t rnd[ALEA_BLOCK_LEN / 2];                                          \
+    int64_t blk[ALEA_BLOCK_LEN];                                               \
+    for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {                     \
+      const size_t len =                                                       \
+          dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;         \
+      alea_get_random_bytes(state, (uint8_t *)rnd,                             \
+                            len / 2 * sizeof(uint64_t));                       \
+      alea_gaussian_block(rnd, blk, len / 2, stdev);                           \
+      alea_narrow_##WIDTH(dst + i, blk, len);                                  \
+    }                                                                          \
+                                                                               \
+    memset(rnd, 0, sizeof(rnd));                                               \
+    memset(blk, 0, sizeof(blk));                                               \
+    return ALEA_RETURN_OK;                                                     \
+  }
+
+ALEA_DEFINE_GAUSSIAN_ARRAY(int32_t, int32)
+ALEA_DEFINE_GAUSSIAN_ARRAY(int16_t, int16)
+ALEA_DEFINE_GAUSSIAN_ARRAY(int8_t, int8)
+
+// Continuous Box-Muller without rounding. Each pair takes two words instead
+// of the halves of one, so that the outputs have full double precision: a
+// 64-bit angle, and a radius from a 53-bit uniform in (0, 1], which also
+// extends the tail from 6.66 to 8.57 standard deviations.
+static void alea_gaussian_double_block(const uint64_t *const rnd,
+                                       double *const dst,
+                                       const size_t num_pairs,
+                                       const double stdev) {
+  for (size_t i = 0; i < num_pairs; i++) {
+    const double u = (double)((rnd[2 * i + 1] >> 11) + 1) * 0x1p-53;
+    const double rr = sqrt(-2.0 * alea_log(u)) * stdev;
+    double c, s;
+    alea_sincos_turn64(rnd[2 * i], &c, &s);
+
+    dst[2 * i] = rr * c;
+    dst[2 * i + 1] = rr * s;
+  }
+}
+
+alea_return alea_sample_gaussian_double_array(alea_state *state,
+                                              double *const dst,
+                                              const size_t dst_len,
+                                              const double stdev) {
+  assert(dst_len % 2 == 0);
+
+  uint64_t rnd[ALEA_BLOCK_LEN];
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_get_random_bytes(state, (uint8_t *)rnd, len * sizeof(uint64_t));
+    alea_gaussian_double_block(rnd, dst + i, len / 2, stdev);
+  }
 
-    // Box-Muller Transform
-    const uint64_t rn1 = rnd >> 32;
-    const uint64_t rn2 = rnd & UINT64_C(0xFFFFFFFF);
-    const double r1 = (double)rn1 / 4294967296.; // 2^32 = 4294967296
-    const double r2 = ((double)rn2 + 1.0) / 4294967296.;
-    const double theta = r1 * ALEA_TWO_PI;
-    const double rr = sqrt(-2.0 * log(r2)) * stdev;
+  memset(rnd, 0, sizeof(rnd));
+  return ALEA_RETURN_OK;
+}
 
-    dst[i] = llround(rr * cos(theta));
-    dst[i + 1] = llround(rr * sin(theta));
+#undef ALEA_LN2_HI
+#undef ALEA_LN2_LO
+#undef ALEA_SQRT2
+#undef ALEA_PI_2
+
+#define ALEA_GAUSSIAN_TABLE_MAX_LEN 65536
+
+// Cumulative distribution table for the discrete Gaussian D_{Z, sigma}
+// truncated to [-len, len]. Entry k holds 2^precision * P(|X| > k), so the
+// magnitude of a sample is the number of entries above a uniform
+// precision-bit draw.
+struct alea_gaussian_table {
+  uint64_t *cdt;
+  size_t len;
+  unsigned precision;
+};
+
+alea_gaussian_table *alea_gaussian_table_create(const double sigma,
+                                                const double tailcut,
+                                                const unsigned precision) {
+  if (!(sigma > 0) || !(tailcut > 0) || precision < 1 || precision > 64)
+    return NULL;
+
+  // The scan is linear in the table length; anything this long belongs to the
+  // convolution sampler instead.
+  const double bound = ceil(tailcut * sigma);
+  if (bound > ALEA_GAUSSIAN_TABLE_MAX_LEN)
+    return NULL;
+
+  alea_gaussian_table *new = malloc(sizeof(alea_gaussian_table));
+  if (new == NULL)
+    return NULL;
+
+  new->len = (size_t)bound;
+  new->precision = precision;
+  new->cdt = malloc(new->len * sizeof(*(new->cdt)));
+  if (new->cdt == NULL) {
+    free(new);
+    return NULL;
   }
 
+  alea_cdt_fill(new->cdt, new->len, sigma, 0, precision);
+  return new;
+}
+
+alea_return alea_gaussian_table_free(alea_gaussian_table *table) {
+  safe_free(table->cdt, table->len * sizeof(*(table->cdt)));
+  safe_free(table, sizeof(alea_gaussian_table));
+
   return ALEA_RETURN_OK;
 }
 
-alea_return alea_sample_gaussian_int32_array(alea_state *state,
-                                             int32_t *const dst,
-                                             const size_t dst_len,
-                                             const double stdev) {
+// Full-table scan for a block of samples. The inner loop runs over samples, so
+// each table entry is compared against many draws at once, and every sample
+// takes the same number of comparisons.
+static void alea_cdt_block(alea_state *state, alea_bit_cursor *cur,
+                           const alea_gaussian_table *table,
+                           int64_t *const dst, const size_t len) {
+  uint64_t u[ALEA_BLOCK_LEN];
+  uint64_t sign[ALEA_BLOCK_LEN];
+
+  for (size_t j = 0; j < len; j++) {
+    u[j] = alea_bit_cursor_get(state, cur, table->precision);
+    sign[j] = alea_bit_cursor_get(state, cur, 1);
+    dst[j] = 0;
+  }
+  for (size_t k = 0; k < table->len; k++) {
+    const uint64_t c = table->cdt[k];
+    for (size_t j = 0; j < len; j++) {
+      dst[j] += (u[j] < c);
+    }
+  }
+  for (size_t j = 0; j < len; j++) {
+    // x or -x, without a branch on the sign bit
+    dst[j] = (dst[j] ^ -(int64_t)sign[j]) + (int64_t)sign[j];
+  }
+
+  memset(u, 0, sizeof(u));
+  memset(sign, 0, sizeof(sign));
+}
+
+alea_return alea_sample_discrete_gaussian_int64_array(
+    alea_state *state, const alea_gaussian_table *table, int64_t *const dst,
+    const size_t dst_len) {
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_cdt_block(state, cur, table, dst + i, len);
+  }
+  return ALEA_RETURN_OK;
+}
+
+// Defines alea_sample_discrete_gaussian_<WIDTH>_array on top of the CDT
+// kernel. Samples lie in [-table->len, table->len], which must fit in TYPE.
+#define ALEA_DEFINE_DISCRETE_GAUSSIAN_ARRAY(TYPE, WIDTH, MAX)                  \
+  alea_return alea_sample_discrete_gaussian_##WIDTH##_array(                   \
+      alea_state *state, const alea_gaussian_table *table, TYPE *const dst,    \
+      const size_t dst_len) {                                                  \
+    assert(table->len <= (size_t)MAX);                                         \
+    int64_t blk[ALEA_BLOCK_LEN];                                               \
+    alea_bit_cursor *cur = alea_get_bit_cursor(state);                         \
+                                                                               \
+    for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {                     \
+      const size_t len =                                                       \
+          dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;         \
+      alea_cdt_block(state, cur, table, blk, len);                             \
+      alea_narrow_##WIDTH(dst + i, blk, len);                                  \
+    }                                                                          \
+                                                                               \
+    memset(blk, 0, sizeof(blk));                                               \
+    return ALEA_RETURN_OK;                                                     \
+  }
+
+ALEA_DEFINE_DISCRETE_GAUSSIAN_ARRAY(int32_t, int32, INT32_MAX)
+ALEA_DEFINE_DISCRETE_GAUSSIAN_ARRAY(int16_t, int16, INT16_MAX)
+ALEA_DEFINE_DISCRETE_GAUSSIAN_ARRAY(int8_t, int8, INT8_MAX)
+
+// Centered draws start from a CDT at sigma = 12; wider than the coset base, so
+// that fewer convolution levels are needed.
+#define ALEA_GAUSSIAN_LEVEL0_SIGMA 12.0
+#define ALEA_GAUSSIAN_MAX_LEVELS 4
+// Rounding off the center uses cosets of 2Z, sampled at sigma = 4 around 0
+// and 1/2. Entries beyond 9.5 sigma are below 2^-64 and round to zero.
+#define ALEA_GAUSSIAN_BASE_SIGMA 4.0
+#define ALEA_GAUSSIAN_BASE_LEN 38
+#define ALEA_GAUSSIAN_CENTER_BITS 32
+// Smoothing parameter of Z for epsilon = 2^-64, as a standard deviation.
+#define ALEA_GAUSSIAN_ETA 1.511
+
+struct alea_gaussian_sampler {
+  alea_gaussian_table *level0;
+  uint64_t cdt[2][ALEA_GAUSSIAN_BASE_LEN]; // coset bases at offsets 0 and 1/2
+  int64_t weight[1 << ALEA_GAUSSIAN_MAX_LEVELS];
+  size_t leaves;
+  uint64_t scale; // sqrt(sigma^2 - sigma_c^2) / sigma_L, in 0.64 fixed point
+};
+
+alea_gaussian_sampler *alea_gaussian_sampler_create(const double sigma) {
+  const double base = ALEA_GAUSSIAN_BASE_SIGMA;
+  // Rounding off k fractional bits adds coset draws of width 2 * base, scaled
+  // by 2^-1 .. 2^-k.
+  const double sigma_c2 = 4.0 * base * base *
+                          (1.0 - ldexp(1.0, -2 * ALEA_GAUSSIAN_CENTER_BITS)) /
+                          3.0;
+  if (!(sigma * sigma >= sigma_c2))
+    return NULL;
+
+  // Level i combines two level i - 1 draws as z x1 + z' x2. The smoothing
+  // condition bounds z by sigma_{i-1} / (sqrt(2) eta), and z' = z - 1 keeps
+  // the two coprime.
+  int64_t z[ALEA_GAUSSIAN_MAX_LEVELS][2];
+  double sigma_l = ALEA_GAUSSIAN_LEVEL0_SIGMA;
+  unsigned levels = 0;
+  while (sigma_l < sigma) {
+    if (levels == ALEA_GAUSSIAN_MAX_LEVELS)
+      return NULL;
+    const int64_t zi = (int64_t)(sigma_l / (sqrt(2.0) * ALEA_GAUSSIAN_ETA));
+    z[levels][0] = zi;
+    z[levels][1] = zi - 1;
+    sigma_l *= sqrt((double)(z[levels][0] * z[levels][0]) +
+                    (double)(z[levels][1] * z[levels][1]));
+    levels++;
+  }
+
+  alea_gaussian_sampler *new = malloc(sizeof(alea_gaussian_sampler));
+  if (new == NULL)
+    return NULL;
+
+  new->level0 = alea_gaussian_table_create(ALEA_GAUSSIAN_LEVEL0_SIGMA, 9.5, 64);
+  if (new->level0 == NULL) {
+    free(new);
+    return NULL;
+  }
+  alea_cdt_fill(new->cdt[0], ALEA_GAUSSIAN_BASE_LEN, base, 0, 64);
+  alea_cdt_fill(new->cdt[1], ALEA_GAUSSIAN_BASE_LEN, base, 0.5, 64);
+
+  // Unrolled, level L is a weighted sum of 2^L level-0 draws, and the weight
+  // of a draw is the product of the multipliers on its path.
+  new->leaves = (size_t)1 << levels;
+  for (size_t leaf = 0; leaf < new->leaves; leaf++) {
+    int64_t w = 1;
+    for (unsigned i = 0; i < levels; i++) {
+      w *= z[i][(leaf >> i) & 1];
+    }
+    new->weight[leaf] = w;
+  }
+
+  const double scaled = ldexp(sqrt(sigma * sigma - sigma_c2) / sigma_l, 64);
+  new->scale = scaled >= 0x1p64 ? UINT64_MAX : (uint64_t)scaled;
+
+  return new;
+}
+
+alea_return alea_gaussian_sampler_free(alea_gaussian_sampler *sampler) {
+  alea_gaussian_table_free(sampler->level0);
+  safe_free(sampler, sizeof(alea_gaussian_sampler));
+
+  return ALEA_RETURN_OK;
+}
+
+// Coset draws for a block: draw j comes from D_{Z, 4, coset[j] / 2}. Both
+// tables are scanned in a single pass with a masked select, so the coset bits
+// stay secret.
+static void alea_gaussian_coset_block(alea_state *state, alea_bit_cursor *cur,
+                                      const alea_gaussian_sampler *sampler,
+                                      const int64_t *coset, int64_t *const dst,
+                                      const size_t len) {
+  uint64_t u[ALEA_BLOCK_LEN];
+  uint64_t sign[ALEA_BLOCK_LEN];
+  uint64_t mask[ALEA_BLOCK_LEN];
+
+  for (size_t j = 0; j < len; j++) {
+    u[j] = alea_bit_cursor_get(state, cur, 64);
+    sign[j] = alea_bit_cursor_get(state, cur, 1);
+    mask[j] = 0 - (uint64_t)coset[j];
+    dst[j] = 0;
+  }
+  for (size_t k = 0; k < ALEA_GAUSSIAN_BASE_LEN; k++) {
+    const uint64_t c = sampler->cdt[0][k];
+    const uint64_t d = c ^ sampler->cdt[1][k];
+    for (size_t j = 0; j < len; j++) {
+      dst[j] += (u[j] < (c ^ (d & mask[j])));
+    }
+  }
+  for (size_t j = 0; j < len; j++) {
+    // m (+1 at offset 1/2) or -m, without a branch on the sign bit
+    const int64_t neg = (int64_t)(sign[j] ^ 1);
+    const int64_t m = dst[j] + (int64_t)(mask[j] & sign[j]);
+    dst[j] = (m ^ -neg) + neg;
+  }
+
+  memset(u, 0, sizeof(u));
+  memset(sign, 0, sizeof(sign));
+  memset(mask, 0, sizeof(mask));
+}
+
+alea_return alea_sample_discrete_gaussian_center_int64_array(
+    alea_state *state, const alea_gaussian_sampler *sampler,
+    const double *centers, int64_t *const dst, const size_t dst_len) {
+  int64_t x[ALEA_BLOCK_LEN];
+  int64_t frac[ALEA_BLOCK_LEN];
+  int64_t bit[ALEA_BLOCK_LEN];
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+
+    // A centered draw y of width sigma_L, accumulated in dst.
+    memset(dst + i, 0, len * sizeof(int64_t));
+    for (size_t leaf = 0; leaf < sampler->leaves; leaf++) {
+      alea_cdt_block(state, cur, sampler->level0, x, len);
+      for (size_t j = 0; j < len; j++) {
+        dst[i + j] += sampler->weight[leaf] * x[j];
+      }
+    }
+
+    // c + K y in 64.64 fixed point; the integer part goes to dst and the top
+    // fractional bits to frac.
+    for (size_t j = 0; j < len; j++) {
+      const uint64_t y = (uint64_t)dst[i + j];
+      uint64_t lo;
+      uint64_t hi = alea_mul_hi64(y, sampler->scale, &lo);
+      hi -= sampler->scale & (0 - (y >> 63)); // y is signed
+
+      if (centers != NULL) {
+        const double c = centers[i + j];
+        assert(fabs(c) < 0x1p62);
+        const double c_floor = floor(c);
+        // c - c_floor is exact for |c| >= 1, but for c in (-2^-54, 0) it
+        // rounds up to 1; carry that into the integer part.
+        const int carry = c - c_floor >= 1.0;
+        const int64_t c_int = (int64_t)c_floor + carry;
+        const uint64_t c_frac =
+            (uint64_t)((c - c_floor - (double)carry) * 0x1p64);
+        lo += c_frac;
+        hi += (uint64_t)c_int + (lo < c_frac);
+      }
+
+      dst[i + j] = (int64_t)hi;
+      frac[j] = (int64_t)(lo >> (64 - ALEA_GAUSSIAN_CENTER_BITS));
+    }
+
+    // Round frac / 2^k to an integer one bit at a time: with b the lowest bit
+    // of frac, a draw x from D_{2Z + b, 8} makes frac + x even, and halving it
+    // drops a fractional bit.
+    for (int k = 0; k < ALEA_GAUSSIAN_CENTER_BITS; k++) {
+      for (size_t j = 0; j < len; j++) {
+        bit[j] = (int64_t)((uint64_t)frac[j] & 1);
+      }
+      alea_gaussian_coset_block(state, cur, sampler, bit, x, len);
+      for (size_t j = 0; j < len; j++) {
+        frac[j] = (frac[j] + 2 * x[j] - bit[j]) / 2;
+      }
+    }
+    for (size_t j = 0; j < len; j++) {
+      dst[i + j] += frac[j];
+    }
+  }
+
+  memset(x, 0, sizeof(x));
+  memset(frac, 0, sizeof(frac));
+  memset(bit, 0, sizeof(bit));
+  return ALEA_RETURN_OK;
+}
+
+// Fused reduction into RNS residues. Each modulus q gets a constant c, 1 for
+// the standard representation or 2^64 mod q for Montgomery, and its Shoup
+// companion w = floor(c * 2^64 / q). For any 64-bit a, a * c - mulhi(a, w) * q
+// is congruent to a * c modulo q and lies in [0, 2q), so one conditional
+// subtraction reduces it. The magnitude of a sample is reduced this way and
+// negated modulo q for negative samples, without branches on the sample.
+typedef struct {
+  uint64_t q;
+  uint64_t c;
+  uint64_t w;
+} alea_modulus;
+
+// floor(hi * 2^64 / q) for hi < q, by long division. Only used on public
+// moduli.
+inline static uint64_t alea_div_wide(uint64_t hi, const uint64_t q) {
+  uint64_t quo = 0;
+  for (int i = 0; i < 64; i++) {
+    const uint64_t carry = hi >> 63;
+    hi <<= 1;
+    quo <<= 1;
+    if (carry || hi >= q) {
+      hi -= q;
+      quo |= 1;
+    }
+  }
+  return quo;
+}
+
+inline static void alea_modulus_init(alea_modulus *mod, const uint64_t q,
+                                     const alea_repr repr) {
+  assert(q >= 2 && q < (UINT64_C(1) << 63));
+  mod->q = q;
+  mod->c = repr == ALEA_REPR_MONTGOMERY ? (0 - q) % q : 1;
+  mod->w = alea_div_wide(mod->c, q);
+}
+
+static alea_modulus *alea_moduli_create(const uint64_t *moduli,
+                                        const size_t num_moduli,
+                                        const alea_repr repr) {
+  assert(num_moduli >= 1);
+
+  alea_modulus *mods = malloc(num_moduli * sizeof(alea_modulus));
+  if (mods == NULL)
+    return NULL;
+
+  for (size_t l = 0; l < num_moduli; l++) {
+    alea_modulus_init(mods + l, moduli[l], repr);
+  }
+  return mods;
+}
+
+// Negates the residue r in [0, q) modulo q where `neg` is all ones.
+inline static uint64_t alea_rns_negate(const uint64_t r, const uint64_t neg,
+                                       const uint64_t q) {
+  uint64_t s = q - r;
+  s -= q & (0 - (uint64_t)(s >= q)); // q - 0 folds back to 0
+  return (r & ~neg) | (s & neg);
+}
+
+// Shoup multiplication of `mag` by c, as a residue in [0, q).
+inline static uint64_t alea_rns_shoup(const uint64_t mag, const uint64_t q,
+                                      const uint64_t c, const uint64_t w) {
+  uint64_t lo;
+  const uint64_t quo = alea_mul_hi64(mag, w, &lo);
+  uint64_t r = mag * c - quo * q; // exact, since it is below 2q
+  r -= q & (0 - (uint64_t)(r >= q));
+  return r;
+}
+
+// Writes the residues of blk[0..len) to positions offset..offset + len of
+// every limb. `bound` is a public bound on the magnitudes: standard residues
+// of samples below q in magnitude need no reduction, only a conditional
+// negation. The signs and magnitudes are split once per block, and each limb
+// is then a single pass with its constants in registers.
+static void alea_rns_scatter(const int64_t *blk, const size_t len,
+                             const uint64_t bound, uint64_t *const dst,
+                             const size_t dst_len, const size_t offset,
+                             const alea_modulus *mods,
+                             const size_t num_moduli) {
+  uint64_t mag[ALEA_BLOCK_LEN], neg[ALEA_BLOCK_LEN];
+  for (size_t j = 0; j < len; j++) {
+    neg[j] = 0 - ((uint64_t)blk[j] >> 63);
+    mag[j] = ((uint64_t)blk[j] ^ neg[j]) - neg[j];
+  }
+
+  for (size_t l = 0; l < num_moduli; l++) {
+    const uint64_t q = mods[l].q, c = mods[l].c, w = mods[l].w;
+    uint64_t *limb = dst + l * dst_len + offset;
+    if (c == 1 && bound < q) {
+      for (size_t j = 0; j < len; j++) {
+        limb[j] = alea_rns_negate(mag[j], neg[j], q);
+      }
+    } else if (c == 1) {
+      for (size_t j = 0; j < len; j++) {
+        limb[j] = alea_rns_negate(alea_rns_shoup(mag[j], q, 1, w), neg[j], q);
+      }
+    } else {
+      for (size_t j = 0; j < len; j++) {
+        limb[j] = alea_rns_negate(alea_rns_shoup(mag[j], q, c, w), neg[j], q);
+      }
+    }
+  }
+
+  memset(mag, 0, sizeof(mag));
+  memset(neg, 0, sizeof(neg));
+}
+
+alea_return alea_sample_cbd_rns(alea_state *state, uint64_t *const dst,
+                                const size_t dst_len,
+                                const size_t cbd_num_flips,
+                                const uint64_t *moduli, const size_t num_moduli,
+                                const alea_repr repr) {
+  alea_modulus *mods = alea_moduli_create(moduli, num_moduli, repr);
+  if (mods == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
+
+  int64_t blk[ALEA_BLOCK_LEN];
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_cbd_kernel(state, cur, blk, len, cbd_num_flips);
+    alea_rns_scatter(blk, len, cbd_num_flips, dst, dst_len, i, mods,
+                     num_moduli);
+  }
+
+  memset(blk, 0, sizeof(blk));
+  free(mods);
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_sample_gaussian_rns(alea_state *state, uint64_t *const dst,
+                                     const size_t dst_len, const double stdev,
+                                     const uint64_t *moduli,
+                                     const size_t num_moduli,
+                                     const alea_repr repr) {
+  assert(dst_len % 2 == 0);
+
+  alea_modulus *mods = alea_moduli_create(moduli, num_moduli, repr);
+  if (mods == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
+
+  // The radius of a pair is at most sqrt(-2 ln 2^-32) * stdev < 6.67 * stdev.
+  const double max = 6.67 * stdev + 1.0;
+  const uint64_t bound = max < 0x1p63 ? (uint64_t)max : UINT64_MAX;
+
+  uint64_t rnd[ALEA_BLOCK_LEN / 2];
+  int64_t blk[ALEA_BLOCK_LEN];
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_get_random_bytes(state, (uint8_t *)rnd, len / 2 * sizeof(uint64_t));
+    alea_gaussian_block(rnd, blk, len / 2, stdev);
+    alea_rns_scatter(blk, len, bound, dst, dst_len, i, mods, num_moduli);
+  }
+
+  memset(rnd, 0, sizeof(rnd));
+  memset(blk, 0, sizeof(blk));
+  free(mods);
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_sample_hwt_rns(alea_state *state, uint64_t *const dst,
+                                const size_t dst_len, const int hwt,
+                                const uint64_t *moduli, const size_t num_moduli,
+                                const alea_repr repr) {
+  alea_modulus *mods = alea_moduli_create(moduli, num_moduli, repr);
+  if (mods == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
+
+  // The positions are not independent, so the vector is sampled whole into
+  // the first limb, then reduced block by block. Each block is copied out
+  // before the first limb is overwritten.
+  alea_return ret =
+      alea_sample_hwt_int64_array(state, (int64_t *)dst, dst_len, hwt);
+  if (ret == ALEA_RETURN_OK) {
+    int64_t blk[ALEA_BLOCK_LEN];
+    for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+      const size_t len =
+          dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+      memcpy(blk, dst + i, len * sizeof(int64_t));
+      alea_rns_scatter(blk, len, 1, dst, dst_len, i, mods, num_moduli);
+    }
+    memset(blk, 0, sizeof(blk));
+  }
+
+  free(mods);
+  return ret;
+}
+
+alea_return alea_sample_ternary_rns(alea_state *state, uint64_t *const dst,
+                                    const size_t dst_len, const double rho,
+                                    const uint64_t *moduli,
+                                    const size_t num_moduli,
+                                    const alea_repr repr) {
+  alea_modulus *mods = alea_moduli_create(moduli, num_moduli, repr);
+  if (mods == NULL)
+    return ALEA_RETURN_BAD_MALLOC_FAILURE;
+
+  int64_t blk[ALEA_BLOCK_LEN];
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_ternary_params tp;
+  alea_ternary_params_init(&tp, rho);
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_ternary_kernel(state, cur, blk, len, &tp);
+    alea_rns_scatter(blk, len, 1, dst, dst_len, i, mods, num_moduli);
+  }
+
+  memset(blk, 0, sizeof(blk));
+  free(mods);
+  return ALEA_RETURN_OK;
+}
+
+// Fused accumulation of noise into a polynomial modulo q: each block is added
+// to dst in place, reduced like alea_rns_scatter does, so no N-entry
+// temporary is needed. A sample below q in magnitude only needs q added when
+// it is negative, and the sum of two residues at most one subtraction of q.
+static void alea_add_mod_q_block(const int64_t *blk, const size_t len,
+                                 const uint64_t bound, uint64_t *const dst,
+                                 const alea_modulus *mod) {
+  const uint64_t q = mod->q, w = mod->w;
+  if (bound < q) {
+    for (size_t j = 0; j < len; j++) {
+      const uint64_t neg = 0 - ((uint64_t)blk[j] >> 63);
+      const uint64_t r = dst[j] + (uint64_t)blk[j] + (q & neg);
+      dst[j] = r - (q & (0 - (uint64_t)(r >= q)));
+    }
+  } else {
+    for (size_t j = 0; j < len; j++) {
+      const uint64_t neg = 0 - ((uint64_t)blk[j] >> 63);
+      const uint64_t mag = ((uint64_t)blk[j] ^ neg) - neg;
+      const uint64_t r =
+          dst[j] + alea_rns_negate(alea_rns_shoup(mag, q, 1, w), neg, q);
+      dst[j] = r - (q & (0 - (uint64_t)(r >= q)));
+    }
+  }
+}
+
+alea_return alea_add_cbd_mod_q(alea_state *state, uint64_t *const dst,
+                               const size_t dst_len, const size_t cbd_num_flips,
+                               const uint64_t q) {
+  alea_modulus mod;
+  alea_modulus_init(&mod, q, ALEA_REPR_STANDARD);
+
+  int64_t blk[ALEA_BLOCK_LEN];
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_cbd_kernel(state, cur, blk, len, cbd_num_flips);
+    alea_add_mod_q_block(blk, len, cbd_num_flips, dst + i, &mod);
+  }
+
+  memset(blk, 0, sizeof(blk));
+  return ALEA_RETURN_OK;
+}
+
+alea_return alea_add_gaussian_mod_q(alea_state *state, uint64_t *const dst,
+                                    const size_t dst_len, const double stdev,
+                                    const uint64_t q) {
   assert(dst_len % 2 == 0);
 
-  for (size_t i = 0; i < dst_len; i += 2) {
-    const uint64_t rnd = alea_get_random_uint64(state);
+  alea_modulus mod;
+  alea_modulus_init(&mod, q, ALEA_REPR_STANDARD);
+
+  // Same bound as in alea_sample_gaussian_rns.
+  const double max = 6.67 * stdev + 1.0;
+  const uint64_t bound = max < 0x1p63 ? (uint64_t)max : UINT64_MAX;
+
+  uint64_t rnd[ALEA_BLOCK_LEN / 2];
+  int64_t blk[ALEA_BLOCK_LEN];
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_get_random_bytes(state, (uint8_t *)rnd, len / 2 * sizeof(uint64_t));
+    alea_gaussian_block(rnd, blk, len / 2, stdev);
+    alea_add_mod_q_block(blk, len, bound, dst + i, &mod);
+  }
 
-    // Box-Muller Transform
-    const uint64_t rn1 = rnd >> 32;
-    const uint64_t rn2 = rnd & UINT64_C(0xFFFFFFFF);
-    const double r1 = (double)rn1 / 4294967296.; // 2^32 = 4294967296
-    const double r2 = ((double)rn2 + 1.0) / 4294967296.;
-    const double theta = r1 * ALEA_TWO_PI;
-    const double rr = sqrt(-2.0 * log(r2)) * stdev;
+  memset(rnd, 0, sizeof(rnd));
+  memset(blk, 0, sizeof(blk));
+  return ALEA_RETURN_OK;
+}
 
-    dst[i] = (int32_t)lround(rr * cos(theta));
-    dst[i + 1] = (int32_t)lround(rr * sin(theta));
+alea_return alea_add_ternary_mod_q(alea_state *state, uint64_t *const dst,
+                                   const size_t dst_len, const double rho,
+                                   const uint64_t q) {
+  alea_modulus mod;
+  alea_modulus_init(&mod, q, ALEA_REPR_STANDARD);
+
+  int64_t blk[ALEA_BLOCK_LEN];
+  alea_bit_cursor *cur = alea_get_bit_cursor(state);
+  alea_ternary_params tp;
+  alea_ternary_params_init(&tp, rho);
+  for (size_t i = 0; i < dst_len; i += ALEA_BLOCK_LEN) {
+    const size_t len =
+        dst_len - i < ALEA_BLOCK_LEN ? dst_len - i : ALEA_BLOCK_LEN;
+    alea_ternary_kernel(state, cur, blk, len, &tp);
+    alea_add_mod_q_block(blk, len, 1, dst + i, &mod);
   }
 
+  memset(blk, 0, sizeof(blk));
   return ALEA_RETURN_OK;
 }
 
@@ -388,5 +2128,3 @@ alea_return alea_hkdf(const uint8_t *ikm, size_t ikm_len, const uint8_t *salt,
   hkdf(ikm, ikm_len, salt, salt_len, info, info_len, okm, okm_len);
   return ALEA_RETURN_OK;
 }
-
-#undef ALEA_TWO_PI
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2025 CryptoLab, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Generates a bitsliced, constant-time sampler for the discrete Gaussian with a
+// fixed sigma. It is run at build time by `alea_add_gaussian_sampler` (see
+// cmake/gaussian.cmake), once for each requested sigma.
+//
+// Usage: dgauss-gen <sigma> <tailcut> <precision> <suffix> <out.c> <out.h>
+//
+// The generated sampler is the CDT sampler of `alea_gaussian_table` turned into
+// a Boolean circuit (Karmakar et al., https://eprint.iacr.org/2018/1182). 64
+// samples are processed at once: random word i holds bit i of the uniform
+// draw of every sample, so the comparison against each table constant becomes
+// a chain of AND/OR operations whose shape is fixed by the constant's bits.
+// Since the comparison results form a thermometer code, the magnitude's bit j
+// is the XOR of every 2^j-th result. The output is then transposed back to one
+// integer per sample.
+
+#include "../alea-cdt.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TABLE_LEN 4096
+
+static uint64_t cdt[MAX_TABLE_LEN];
+
+static int usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s <sigma> <tailcut> <precision> <suffix> <out.c> <out.h>\n",
+          prog);
+  return 1;
+}
+
+static unsigned bit_length(size_t x) {
+  unsigned len = 0;
+  while (x != 0) {
+    len++;
+    x >>= 1;
+  }
+  return len;
+}
+
+static void write_header(FILE *out, const char *suffix, const double sigma,
+                         const double tailcut, const unsigned precision) {
+  char guard[64];
+  size_t i;
+  for (i = 0; suffix[i] != '\0'; i++) {
+    guard[i] = (char)(suffix[i] >= 'a' && suffix[i] <= 'z'
+                          ? suffix[i] - 'a' + 'A'
+                          : suffix[i]);
+  }
+  guard[i] = '\0';
+
+  fprintf(out, "// Generated by dgauss-gen. Do not edit.\n\n");
+  fprintf(out, "#ifndef ALEA_DGAUSS_%s_H\n#define ALEA_DGAUSS_%s_H\n\n", guard,
+          guard);
+  fprintf(out, "#include \"alea/alea.h\"\n\n");
+  fprintf(out, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n");
+  fprintf(out,
+          "/**\n"
+          " * @brief Fills the destination array with random integers sampled "
+          "from the\n"
+          " * discrete Gaussian with sigma = %g.\n"
+          " *\n"
+          " * Generated for tail cut %g and %u-bit precision. The sampler is a "
+          "bitsliced\n"
+          " * Boolean circuit that produces 64 samples per pass; its running "
+          "time\n"
+          " * depends only on `dst_len`.\n"
+          " */\n",
+          sigma, tailcut, precision);
+  fprintf(out,
+          "ALEA_API alea_return alea_sample_dgauss_%s_int64_array(\n"
+          "    alea_state *state, int64_t *const dst, "
+          "const size_t dst_len);\n\n",
+          suffix);
+  fprintf(out,
+          "/** @copydoc alea_sample_dgauss_%s_int64_array */\n"
+          "ALEA_API alea_return alea_sample_dgauss_%s_int32_array(\n"
+          "    alea_state *state, int32_t *const dst, "
+          "const size_t dst_len);\n\n",
+          suffix, suffix);
+  fprintf(out, "#ifdef __cplusplus\n}\n#endif\n\n");
+  fprintf(out, "#endif // ALEA_DGAUSS_%s_H\n", guard);
+}
+
+static void write_array_function(FILE *out, const char *suffix,
+                                 const char *type, const char *width,
+                                 const unsigned precision) {
+  fprintf(out,
+          "alea_return alea_sample_dgauss_%s_%s_array(alea_state *state,\n"
+          "    %s *const dst, const size_t dst_len) {\n",
+          suffix, width, type);
+  fprintf(out, "  uint64_t r[%u];\n  int64_t batch[64];\n\n", precision + 1);
+  fprintf(out, "  for (size_t i = 0; i < dst_len; i += 64) {\n");
+  fprintf(out, "    alea_get_random_uint64_array(state, r, %u);\n",
+          precision + 1);
+  fprintf(out, "    alea_dgauss_%s_batch(r, batch);\n", suffix);
+  fprintf(out, "    const size_t len = dst_len - i < 64 ? dst_len - i : 64;\n");
+  fprintf(out, "    for (size_t j = 0; j < len; j++) {\n");
+  fprintf(out, "      dst[i + j] = (%s)batch[j];\n", type);
+  fprintf(out, "    }\n  }\n\n");
+  fprintf(out, "  memset(r, 0, sizeof(r));\n");
+  fprintf(out, "  memset(batch, 0, sizeof(batch));\n");
+  fprintf(out, "  return ALEA_RETURN_OK;\n}\n\n");
+}
+
+static void write_source(FILE *out, const char *suffix, const char *header,
+                         const double sigma, const double tailcut,
+                         const size_t len, const unsigned precision) {
+  const unsigned planes = bit_length(len);
+
+  fprintf(out, "// Generated by dgauss-gen. Do not edit.\n");
+  fprintf(out, "// sigma = %.17g, tailcut = %.17g, precision = %u\n\n", sigma,
+          tailcut, precision);
+  fprintf(out, "#include \"%s\"\n\n", header);
+  fprintf(out, "#include <stdint.h>\n#include <string.h>\n\n");
+
+  // r[0..precision) are the bit planes of the uniform draws, r[precision] holds
+  // the sign bits.
+  fprintf(out,
+          "static void alea_dgauss_%s_batch(const uint64_t r[%u], "
+          "int64_t out[64]) {\n",
+          suffix, precision + 1);
+  fprintf(out, "  uint64_t nb[%u];\n", precision);
+  fprintf(out, "  for (int i = 0; i < %u; i++) {\n    nb[i] = ~r[i];\n  }\n\n",
+          precision);
+  fprintf(out, "  uint64_t lt;\n");
+  for (unsigned j = 0; j < planes; j++) {
+    fprintf(out, "  uint64_t m%u = 0;\n", j);
+  }
+
+  for (size_t k = 0; k < len; k++) {
+    const uint64_t c = cdt[k];
+    if (c == 0)
+      continue; // u < 0 never holds
+    fprintf(out, "\n  // u < 0x%016llx\n", (unsigned long long)c);
+    // From the least significant bit up: a set bit of c makes u smaller where
+    // u has a 0 and defers to the lower bits otherwise, a clear bit makes u
+    // larger where u has a 1. Trailing zero bits of c leave lt = 0.
+    unsigned i = 0;
+    while (((c >> i) & 1) == 0) {
+      i++;
+    }
+    fprintf(out, "  lt = nb[%u];\n", i);
+    for (i++; i < precision; i++) {
+      fprintf(out, "  lt %s= nb[%u];\n", ((c >> i) & 1) ? "|" : "&", i);
+    }
+    // lt is the thermometer bit [|x| >= k + 1].
+    for (unsigned j = 0; j < planes; j++) {
+      if ((k + 1) % ((size_t)1 << j) == 0) {
+        fprintf(out, "  m%u ^= lt;\n", j);
+      }
+    }
+  }
+
+  fprintf(out, "\n  for (int j = 0; j < 64; j++) {\n");
+  fprintf(out, "    const uint64_t mag =");
+  for (unsigned j = 0; j < planes; j++) {
+    fprintf(out, "%s((m%u >> j) & 1) << %u", j == 0 ? " " : " |\n        ", j,
+            j);
+  }
+  fprintf(out, ";\n");
+  fprintf(out, "    const uint64_t sign = (r[%u] >> j) & 1;\n", precision);
+  fprintf(out, "    out[j] = (int64_t)((mag ^ (0 - sign)) + sign);\n");
+  fprintf(out, "  }\n\n");
+  fprintf(out, "  memset(nb, 0, sizeof(nb));\n");
+  fprintf(out, "}\n\n");
+
+  write_array_function(out, suffix, "int64_t", "int64", precision);
+  write_array_function(out, suffix, "int32_t", "int32", precision);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 7)
+    return usage(argv[0]);
+
+  const double sigma = strtod(argv[1], NULL);
+  const double tailcut = strtod(argv[2], NULL);
+  const unsigned precision = (unsigned)strtoul(argv[3], NULL, 10);
+  const char *suffix = argv[4];
+
+  if (!(sigma > 0) || !(tailcut > 0) || precision < 1 || precision > 64) {
+    fprintf(stderr, "dgauss-gen: invalid sigma, tailcut or precision\n");
+    return 1;
+  }
+  if (strlen(suffix) == 0 || strlen(suffix) > 32 ||
+      strspn(suffix, "abcdefghijklmnopqrstuvwxyz"
+                     "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_") !=
+          strlen(suffix)) {
+    fprintf(stderr, "dgauss-gen: invalid suffix '%s'\n", suffix);
+    return 1;
+  }
+
+  const double bound = ceil(tailcut * sigma);
+  if (bound > MAX_TABLE_LEN) {
+    fprintf(stderr, "dgauss-gen: table longer than %d entries\n",
+            MAX_TABLE_LEN);
+    return 1;
+  }
+  const size_t len = (size_t)bound;
+  alea_cdt_fill(cdt, len, sigma, 0, precision);
+
+  FILE *src = fopen(argv[5], "w");
+  FILE *hdr = fopen(argv[6], "w");
+  if (src == NULL || hdr == NULL) {
+    fprintf(stderr, "dgauss-gen: cannot open output files\n");
+    return 1;
+  }
+
+  char header[64];
+  snprintf(header, sizeof(header), "alea/dgauss_%s.h", suffix);
+  write_source(src, suffix, header, sigma, tailcut, len, precision);
+  write_header(hdr, suffix, sigma, tailcut, precision);
+
+  fclose(src);
+  fclose(hdr);
+  return 0;
+}
@@ -487,6 +487,31 @@ static void keccak_squeezeblocks(uint8_t *out, size_t nblocks, uint64_t s[25],
   }
 }
 
+/*************************************************
+ * Name:        keccak_xorblocks
+ *
+ * Description: Like keccak_squeezeblocks, but XORs the blocks into out
+ *              instead of overwriting it, one lane at a time.
+ *
+ * Arguments:   - uint8_t *out: pointer to input/output blocks
+ *              - size_t nblocks: number of blocks to be squeezed (XORed into
+ *out)
+ *              - uint64_t *s: pointer to input/output Keccak state
+ *              - unsigned int r: rate in bytes (e.g., 168 for SHAKE128)
+ **************************************************/
+static void keccak_xorblocks(uint8_t *out, size_t nblocks, uint64_t s[25],
+                             unsigned int r) {
+  unsigned int i;
+
+  while (nblocks) {
+    KeccakF1600_StatePermute(s);
+    for (i = 0; i < r / 8; i++)
+      store64(out + 8 * i, load64(out + 8 * i) ^ s[i]);
+    out += r;
+    nblocks -= 1;
+  }
+}
+
 /*************************************************
  * Name:        shake128_init
  *
@@ -574,6 +599,21 @@ void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state) {
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE128_RATE);
 }
 
+/*************************************************
+ * Name:        shake128_xorblocks
+ *
+ * Description: Like shake128_squeezeblocks, but XORs the squeezed blocks
+ *              into out.
+ *
+ * Arguments:   - uint8_t *out: pointer to input/output blocks
+ *              - size_t nblocks: number of blocks to be squeezed (XORed into
+ *output)
+ *              - keccak_state *s: pointer to input/output Keccak state
+ **************************************************/
+void shake128_xorblocks(uint8_t *out, size_t nblocks, keccak_state *state) {
+  keccak_xorblocks(out, nblocks, state->s, SHAKE128_RATE);
+}
+
 /*************************************************
  * Name:        shake256_init
  *
@@ -661,6 +701,21 @@ void shake256_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state) {
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE256_RATE);
 }
 
+/*************************************************
+ * Name:        shake256_xorblocks
+ *
+ * Description: Like shake256_squeezeblocks, but XORs the squeezed blocks
+ *              into out.
+ *
+ * Arguments:   - uint8_t *out: pointer to input/output blocks
+ *              - size_t nblocks: number of blocks to be squeezed (XORed into
+ *output)
+ *              - keccak_state *s: pointer to input/output Keccak state
+ **************************************************/
+void shake256_xorblocks(uint8_t *out, size_t nblocks, keccak_state *state) {
+  keccak_xorblocks(out, nblocks, state->s, SHAKE256_RATE);
+}
+
 /*************************************************
  * Name:        shake128
  *
@@ -27,8 +27,11 @@
 #define TEST_SIZE 100000
 #define TEST_RANGE_32 100
 #define TEST_RANGE_64 (1UL << 33)
+#define TEST_RANGE_SMALL 3
+#define TEST_RANGE_8 200 // 8-bit draws, and 6 bins of 3-sigma tolerance
 #define TEST_HWT (TEST_SIZE * 2 / 3)
 #define TEST_CBD 21
+#define TEST_CBD_WIDE 200
 #define TEST_STD 3.2
 
 #define VERIFY_SIGMA_FACTOR                                                    \
@@ -40,15 +43,32 @@
     TEST_RANGE_32)                                                             \
   X(random_range_64, get_random_uint64_array_in_range, uint64_t, TEST_SIZE,    \
     TEST_RANGE_64)                                                             \
+  X(random_range_16, get_random_uint16_array_in_range, uint16_t, TEST_SIZE,    \
+    TEST_RANGE_32)                                                             \
+  X(random_range_8, get_random_uint8_array_in_range, uint8_t, TEST_SIZE,       \
+    TEST_RANGE_8)                                                              \
+  X(random_small_range_32, get_random_uint32_array_in_range, uint32_t,         \
+    TEST_SIZE, TEST_RANGE_SMALL)                                               \
+  X(random_small_range_64, get_random_uint64_array_in_range, uint64_t,         \
+    TEST_SIZE, TEST_RANGE_32)                                                  \
   X(random_hwt_8, sample_hwt_int8_array, int8_t, TEST_SIZE, TEST_HWT)          \
   X(random_hwt_32, sample_hwt_int32_array, int32_t, TEST_SIZE, TEST_HWT)       \
   X(random_hwt_64, sample_hwt_int64_array, int64_t, TEST_SIZE, TEST_HWT)       \
   X(random_cbd_32, sample_cbd_int32_array, int32_t, TEST_SIZE, TEST_CBD)       \
   X(random_cbd_64, sample_cbd_int64_array, int64_t, TEST_SIZE, TEST_CBD)       \
+  X(random_cbd_16, sample_cbd_int16_array, int16_t, TEST_SIZE, TEST_CBD)       \
+  X(random_cbd_8, sample_cbd_int8_array, int8_t, TEST_SIZE, TEST_CBD)          \
+  X(random_cbd2_32, sample_cbd_int32_array, int32_t, TEST_SIZE, 2)             \
+  X(random_cbd3_64, sample_cbd_int64_array, int64_t, TEST_SIZE, 3)             \
+  X(random_cbd_wide_32, sample_cbd_int32_array, int32_t, TEST_SIZE,            \
+    TEST_CBD_WIDE)                                                             \
   X(random_gaussian_32, sample_gaussian_int32_array, int32_t, TEST_SIZE,       \
     TEST_STD)                                                                  \
   X(random_gaussian_64, sample_gaussian_int64_array, int64_t, TEST_SIZE,       \
-    TEST_STD)
+    TEST_STD)                                                                  \
+  X(random_gaussian_16, sample_gaussian_int16_array, int16_t, TEST_SIZE,       \
+    TEST_STD)                                                                  \
+  X(random_gaussian_8, sample_gaussian_int8_array, int8_t, TEST_SIZE, TEST_STD)
 
 #define DEFINE_FUNCTIONALITY_TEST(NAME, API, TYPE, SIZE, OPT)                  \
   static void test_##NAME(void) {                                              \
@@ -59,6 +79,9 @@
     check_##NAME(dst, SIZE, OPT);                                              \
   }
 
+// When range * VERIFY_SIGMA_TOLER is below one, not a single bin may fall
+// beyond 3 sigma, which a fair sampler still does on about 1% of seeds. Such
+// small ranges get a 5-sigma bound on every bin instead.
 #define CHECK_RANGE(bit)                                                       \
   void check_random_range_##bit(uint##bit##_t *dst, size_t size,               \
                                 uint##bit##_t range) {                         \
@@ -74,6 +97,13 @@
     }                                                                          \
     double expected_count = (double)size / range;                              \
     double sigma = sqrt(expected_count * (1 - 1.0 / range));                   \
+    if (range * VERIFY_SIGMA_TOLER < 1) {                                      \
+      for (size_t i = 0; i < range; ++i) {                                     \
+        const double dev = fabs(count[i] - expected_count);                    \
+        TEST_ASSERT_EQUAL(1, (5.0 * sigma >= dev));                            \
+      }                                                                        \
+      return;                                                                  \
+    }                                                                          \
     int count_out_of_range = 0;                                                \
     for (size_t i = 0; i < range; ++i) {                                       \
       if (abs(count[i] - expected_count) > VERIFY_SIGMA_FACTOR * sigma) {      \
@@ -83,6 +113,8 @@
     TEST_ASSERT_LESS_OR_EQUAL(range * VERIFY_SIGMA_TOLER, count_out_of_range); \
   }
 
+// The signs of the hwt nonzeros are fair coins, so count[2] - count[0] has
+// standard deviation sqrt(hwt).
 #define CHECK_HWT(bit)                                                         \
   void check_random_hwt_##bit(int##bit##_t *dst, size_t size, int hwt) {       \
     int count[3] = {0, 0, 0};                                                  \
@@ -94,7 +126,7 @@
     }                                                                          \
     TEST_ASSERT_EQUAL(size - hwt, count[1]);                                   \
     double diff = abs(count[0] - count[2]);                                    \
-    TEST_ASSERT_EQUAL(1, (VERIFY_SIGMA_FACTOR * sqrt(hwt * 0.5) >= diff));     \
+    TEST_ASSERT_EQUAL(1, (5.0 * sqrt(hwt) >= diff));                           \
   }
 
 #define CHECK_CBD(bit)                                                         \
@@ -166,18 +198,594 @@ void tearDown(void) {
 #define Y(NAME) CHECK_##NAME(32) CHECK_##NAME(64)
 CHECK_FUNTION_LIST
 CHECK_HWT(8)
+CHECK_RANGE(16)
+CHECK_RANGE(8)
+CHECK_CBD(16)
+CHECK_CBD(8)
+CHECK_GAUSSIAN(16)
+CHECK_GAUSSIAN(8)
 #undef Y
+#define check_random_small_range_32 check_random_range_32
+#define check_random_small_range_64 check_random_range_64
+#define check_random_cbd2_32 check_random_cbd_32
+#define check_random_cbd3_64 check_random_cbd_64
+#define check_random_cbd_wide_32 check_random_cbd_32
 
 #define X(NAME, API, TYPE, SIZE, OPT)                                          \
   DEFINE_FUNCTIONALITY_TEST(NAME, API, TYPE, SIZE, OPT)
 FUNCTIONALITY_TEST_LIST
 #undef X
 
+static void test_range_sampler(void) {
+  TEST_ASSERT_NULL(alea_range_sampler_create(1));
+
+  const uint64_t ranges[] = {TEST_RANGE_32, TEST_RANGE_64};
+  uint64_t dst[TEST_SIZE];
+  for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r) {
+    alea_range_sampler *sampler = alea_range_sampler_create(ranges[r]);
+    TEST_ASSERT_NOT_NULL(sampler);
+
+    alea_range_sample_array(g_state_128, sampler, dst, TEST_SIZE);
+    check_random_range_64(dst, TEST_SIZE, ranges[r]);
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      dst[i] = alea_range_sample(g_state_256, sampler);
+    }
+    check_random_range_64(dst, TEST_SIZE, ranges[r]);
+
+    alea_range_sampler_free(sampler);
+  }
+}
+
+// The workspace variants produce what the allocating variants produce from
+// the same stream, and hand the workspace back cleared.
+static void test_hwt_workspace(void) {
+  const size_t ws_size = alea_hwt_workspace_size(TEST_SIZE);
+  uint8_t *workspace = ws_size > 0 ? malloc(ws_size) : NULL;
+  if (ws_size > 0) {
+    TEST_ASSERT_NOT_NULL(workspace);
+  }
+
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE256] = {0};
+  alea_state *a = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+  alea_state *b = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+
+  static int64_t dst64[TEST_SIZE], ref64[TEST_SIZE];
+  alea_sample_hwt_int64_array_workspace(a, dst64, TEST_SIZE, TEST_HWT,
+                                        NULL); // needs none
+  alea_sample_hwt_int64_array(b, ref64, TEST_SIZE, TEST_HWT);
+  static int32_t dst32[TEST_SIZE], ref32[TEST_SIZE];
+  alea_sample_hwt_int32_array_workspace(a, dst32, TEST_SIZE, TEST_HWT,
+                                        workspace);
+  alea_sample_hwt_int32_array(b, ref32, TEST_SIZE, TEST_HWT);
+  static int8_t dst8[TEST_SIZE], ref8[TEST_SIZE];
+  alea_sample_hwt_int8_array_workspace(a, dst8, TEST_SIZE, TEST_HWT,
+                                       workspace);
+  alea_sample_hwt_int8_array(b, ref8, TEST_SIZE, TEST_HWT);
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    TEST_ASSERT_EQUAL(ref64[i], dst64[i]);
+    TEST_ASSERT_EQUAL(ref32[i], dst32[i]);
+    TEST_ASSERT_EQUAL(ref8[i], dst8[i]);
+  }
+  check_random_hwt_8(dst8, TEST_SIZE, TEST_HWT);
+
+  // The workspace held the secret positions and must come back cleared.
+  for (size_t i = 0; i < ws_size; ++i) {
+    TEST_ASSERT_EQUAL(0, workspace[i]);
+  }
+  free(workspace);
+  alea_free(a);
+  alea_free(b);
+}
+
+#define TEST_LARGE_SIZE (1 << 20)
+
+static void test_hwt_large(void) {
+  static int8_t dst[TEST_LARGE_SIZE];
+  alea_sample_hwt_int8_array(g_state_128, dst, TEST_LARGE_SIZE,
+                             TEST_LARGE_SIZE / 3);
+
+  size_t weight = 0;
+  for (size_t i = 0; i < TEST_LARGE_SIZE; ++i) {
+    TEST_ASSERT_EQUAL(1, (dst[i] >= -1 && dst[i] <= 1));
+    weight += dst[i] != 0;
+  }
+  TEST_ASSERT_EQUAL(TEST_LARGE_SIZE / 3, weight);
+
+  // The nonzeros must be spread evenly, up to the very last positions.
+  size_t tail = 0;
+  for (size_t i = TEST_LARGE_SIZE - TEST_SIZE; i < TEST_LARGE_SIZE; ++i) {
+    tail += dst[i] != 0;
+  }
+  TEST_ASSERT_EQUAL(1, (5.0 * sqrt(TEST_SIZE * 2.0 / 9.0) >=
+                        fabs((double)tail - TEST_SIZE / 3.0)));
+}
+
+#define TEST_SPARSE_HWT 4096
+
+static void test_hwt_sparse(void) {
+  static uint32_t idx[TEST_SPARSE_HWT];
+  static int8_t sign[TEST_SPARSE_HWT];
+  alea_sample_hwt_sparse(g_state_128, TEST_SIZE, TEST_SPARSE_HWT, idx, sign);
+
+  int sum = 0;
+  size_t low_half = 0;
+  for (size_t k = 0; k < TEST_SPARSE_HWT; ++k) {
+    TEST_ASSERT_LESS_THAN(TEST_SIZE, idx[k]);
+    if (k > 0) {
+      TEST_ASSERT_LESS_THAN(idx[k], idx[k - 1]); // strictly increasing
+    }
+    TEST_ASSERT_EQUAL(1, (sign[k] == 1 || sign[k] == -1));
+    sum += sign[k];
+    low_half += idx[k] < TEST_SIZE / 2;
+  }
+  TEST_ASSERT_EQUAL(1, (5.0 * sqrt(TEST_SPARSE_HWT) >= fabs((double)sum)));
+  TEST_ASSERT_EQUAL(1, (5.0 * sqrt(TEST_SPARSE_HWT / 4.0) >=
+                        fabs((double)low_half - TEST_SPARSE_HWT / 2.0)));
+
+  // hwt = dst_len takes every position.
+  alea_sample_hwt_sparse(g_state_256, TEST_SPARSE_HWT, TEST_SPARSE_HWT, idx,
+                         sign);
+  for (size_t k = 0; k < TEST_SPARSE_HWT; ++k) {
+    TEST_ASSERT_EQUAL(k, idx[k]);
+  }
+}
+
+#define TEST_HWT_SHORT_RUNS 12000
+
+// A single nonzero in a short vector must land in every position equally
+// often; n = 2, hwt = 1 used to always produce [0, +-1].
+static void test_hwt_short(void) {
+  for (size_t n = 2; n <= 3; ++n) {
+    int count[3] = {0, 0, 0};
+    for (int r = 0; r < TEST_HWT_SHORT_RUNS; ++r) {
+      int8_t dst[3];
+      alea_sample_hwt_int8_array(g_state_128, dst, n, 1);
+      for (size_t i = 0; i < n; ++i) {
+        count[i] += dst[i] != 0;
+      }
+    }
+
+    const double expected = (double)TEST_HWT_SHORT_RUNS / (double)n;
+    const double sigma = sqrt(expected * (1 - 1.0 / (double)n));
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL(1, (5.0 * sigma >= fabs(count[i] - expected)));
+    }
+  }
+}
+
+#define TEST_TAILCUT 12.0
+#define TEST_PRECISION 64
+
+static void test_discrete_gaussian(void) {
+  TEST_ASSERT_NULL(alea_gaussian_table_create(TEST_STD, TEST_TAILCUT, 65));
+
+  alea_gaussian_table *table =
+      alea_gaussian_table_create(TEST_STD, TEST_TAILCUT, TEST_PRECISION);
+  TEST_ASSERT_NOT_NULL(table);
+  const int64_t bound = (int64_t)ceil(TEST_TAILCUT * TEST_STD);
+
+  int64_t dst64[TEST_SIZE];
+  alea_sample_discrete_gaussian_int64_array(g_state_128, table, dst64,
+                                            TEST_SIZE);
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    TEST_ASSERT_LESS_OR_EQUAL(bound, llabs(dst64[i]));
+  }
+  check_random_gaussian_64(dst64, TEST_SIZE, TEST_STD);
+
+  int32_t dst32[TEST_SIZE];
+  alea_sample_discrete_gaussian_int32_array(g_state_256, table, dst32,
+                                            TEST_SIZE);
+  check_random_gaussian_32(dst32, TEST_SIZE, TEST_STD);
+
+  int8_t dst8[TEST_SIZE];
+  alea_sample_discrete_gaussian_int8_array(g_state_128, table, dst8,
+                                           TEST_SIZE);
+  check_random_gaussian_8(dst8, TEST_SIZE, TEST_STD);
+
+  alea_gaussian_table_free(table);
+}
+
+#define TEST_LARGE_STD 1048576.0
+#define TEST_CENTER_STD 8.0
+
+static void test_discrete_gaussian_center(void) {
+  TEST_ASSERT_NULL(alea_gaussian_sampler_create(TEST_STD));
+  TEST_ASSERT_NULL(alea_gaussian_sampler_create(ldexp(1.0, 46)));
+
+  int64_t dst[TEST_SIZE];
+  alea_gaussian_sampler *sampler =
+      alea_gaussian_sampler_create(TEST_LARGE_STD);
+  TEST_ASSERT_NOT_NULL(sampler);
+  alea_sample_discrete_gaussian_center_int64_array(g_state_128, sampler, NULL,
+                                                   dst, TEST_SIZE);
+  check_random_gaussian_64(dst, TEST_SIZE, TEST_LARGE_STD);
+  alea_gaussian_sampler_free(sampler);
+
+  static double centers[TEST_SIZE];
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    centers[i] = (double)(i % 5) * 100.0 - 250.0 + 0.25;
+  }
+  sampler = alea_gaussian_sampler_create(TEST_CENTER_STD);
+  TEST_ASSERT_NOT_NULL(sampler);
+  alea_sample_discrete_gaussian_center_int64_array(g_state_256, sampler,
+                                                   centers, dst, TEST_SIZE);
+  double offset = 0;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    offset += (double)dst[i] - centers[i];
+    dst[i] -= (int64_t)floor(centers[i]);
+  }
+  offset /= TEST_SIZE;
+  TEST_ASSERT_EQUAL(1,
+                    (5.0 * TEST_CENTER_STD / sqrt(TEST_SIZE) >= fabs(offset)));
+  check_random_gaussian_64(dst, TEST_SIZE, TEST_CENTER_STD);
+
+  // Centers at or next to an integer, where the fractional part is 0 or rounds
+  // to 1: the mean must stay at the integer, not one below it.
+  const double edge[] = {-0x1p-60, -0.0, 0x1p52 + 0.5, -0x1p52 - 0.5};
+  for (size_t k = 0; k < sizeof(edge) / sizeof(edge[0]); ++k) {
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      centers[i] = edge[k];
+    }
+    alea_sample_discrete_gaussian_center_int64_array(g_state_128, sampler,
+                                                     centers, dst, TEST_SIZE);
+    const int64_t base = (int64_t)round(edge[k]);
+    offset = 0;
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      offset += (double)(dst[i] - base);
+    }
+    offset /= TEST_SIZE;
+    TEST_ASSERT_EQUAL(
+        1, (5.0 * TEST_CENTER_STD / sqrt(TEST_SIZE) >= fabs(offset)));
+  }
+  alea_gaussian_sampler_free(sampler);
+}
+
+static void check_ternary_counts(const int8_t *dst, const size_t len,
+                                 const double rho) {
+  size_t count[3] = {0, 0, 0};
+  for (size_t i = 0; i < len; ++i) {
+    TEST_ASSERT_EQUAL(1, (dst[i] >= -1 && dst[i] <= 1));
+    count[dst[i] + 1]++;
+  }
+  const double p[3] = {rho / 2, 1 - rho, rho / 2};
+  for (size_t v = 0; v < 3; ++v) {
+    const double expected = (double)len * p[v];
+    TEST_ASSERT_EQUAL(1, (5.0 * sqrt(expected * (1 - p[v]) + 1) >=
+                          fabs((double)count[v] - expected)));
+  }
+}
+
+static void test_ternary(void) {
+  const double rhos[] = {0.5, 1.0 / 64, 0.3, 1.0, ALEA_TERNARY_UNIFORM};
+  static int8_t dst8[TEST_SIZE];
+  static int16_t dst16[TEST_SIZE];
+  static int64_t dst64[TEST_SIZE];
+  for (size_t r = 0; r < sizeof(rhos) / sizeof(rhos[0]); ++r) {
+    alea_sample_ternary_int8_array(g_state_128, dst8, TEST_SIZE, rhos[r]);
+    check_ternary_counts(dst8, TEST_SIZE, rhos[r]);
+    alea_sample_ternary_int64_array(g_state_256, dst64, TEST_SIZE, rhos[r]);
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      dst8[i] = (int8_t)dst64[i];
+    }
+    check_ternary_counts(dst8, TEST_SIZE, rhos[r]);
+    alea_sample_ternary_int16_array(g_state_128, dst16, TEST_SIZE, rhos[r]);
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      dst8[i] = (int8_t)dst16[i];
+    }
+    check_ternary_counts(dst8, TEST_SIZE, rhos[r]);
+  }
+
+  // The packed form holds the same entries as the int32 form of one stream.
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE256] = {0};
+  static int32_t dst32[TEST_SIZE];
+  static uint8_t packed[(TEST_SIZE + 3) / 4];
+  alea_state *a = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+  alea_state *b = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+  alea_sample_ternary_int32_array(a, dst32, TEST_SIZE, 0.5);
+  alea_sample_ternary_packed(b, packed, TEST_SIZE, 0.5);
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    const int code = (packed[i / 4] >> (2 * (i % 4))) & 3;
+    TEST_ASSERT_EQUAL(dst32[i], code == 3 ? -1 : code);
+  }
+  alea_free(a);
+  alea_free(b);
+}
+
+// alea_xor_random_bytes consumes the same stream as alea_get_random_bytes,
+// including across calls that end mid-block.
+static void test_xor_random_bytes(void) {
+  const size_t lens[] = {1, 200, 0, 1000, 168, 136, 7, 3000};
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE256] = {0};
+  static uint8_t expected[TEST_SIZE], buf[TEST_SIZE];
+  for (int algo = 0; algo < 2; ++algo) {
+    const alea_algo algorithm =
+        algo ? ALEA_ALGORITHM_SHAKE256 : ALEA_ALGORITHM_SHAKE128;
+    alea_state *a = alea_init(seed, algorithm);
+    alea_state *b = alea_init(seed, algorithm);
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      buf[i] = (uint8_t)(i * 7);
+    }
+    size_t pos = 0;
+    for (size_t k = 0; k < sizeof(lens) / sizeof(lens[0]); ++k) {
+      alea_get_random_bytes(a, expected + pos, lens[k]);
+      alea_xor_random_bytes(b, buf + pos, lens[k]);
+      pos += lens[k];
+    }
+    for (size_t i = 0; i < pos; ++i) {
+      TEST_ASSERT_EQUAL(expected[i] ^ (uint8_t)(i * 7), buf[i]);
+    }
+    TEST_ASSERT_EQUAL((uint8_t)(pos * 7), buf[pos]);
+    TEST_ASSERT_EQUAL(alea_get_random_uint64(a), alea_get_random_uint64(b));
+    alea_free(a);
+    alea_free(b);
+  }
+}
+
+// Bytes read through alea_peek and alea_consume follow the stream of
+// alea_get_random_bytes, across refills.
+static void test_peek_consume(void) {
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE256] = {0};
+  alea_state *a = alea_init(seed, ALEA_ALGORITHM_SHAKE128);
+  alea_state *b = alea_init(seed, ALEA_ALGORITHM_SHAKE128);
+  static uint8_t expected[TEST_SIZE];
+  alea_get_random_bytes(a, expected, TEST_SIZE);
+
+  size_t pos = 0;
+  for (size_t k = 0; pos < TEST_SIZE; ++k) {
+    size_t avail, again;
+    const uint8_t *p = alea_peek(b, &avail);
+    TEST_ASSERT_EQUAL_PTR(p, alea_peek(b, &again));
+    TEST_ASSERT_EQUAL(avail, again);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, avail);
+
+    size_t n = k % 3 == 0 ? avail : k % 50;
+    n = n < avail ? n : avail;
+    n = n < TEST_SIZE - pos ? n : TEST_SIZE - pos;
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL(expected[pos + i], p[i]);
+    }
+    TEST_ASSERT_EQUAL(ALEA_RETURN_BAD_GENERIC, alea_consume(b, avail + 1));
+    TEST_ASSERT_EQUAL(ALEA_RETURN_OK, alea_consume(b, n));
+    pos += n;
+  }
+  TEST_ASSERT_EQUAL(alea_get_random_uint64(a), alea_get_random_uint64(b));
+  alea_free(a);
+  alea_free(b);
+}
+
+static void check_bernoulli_count(const uint8_t *dst, const size_t len,
+                                  const double p) {
+  size_t ones = 0;
+  for (size_t i = 0; i < len; ++i) {
+    TEST_ASSERT_LESS_OR_EQUAL(1, dst[i]);
+    ones += dst[i];
+  }
+  const double expected = (double)len * p;
+  TEST_ASSERT_EQUAL(1, (5.0 * sqrt(expected * (1 - p) + 1) >=
+                        fabs((double)ones - expected)));
+}
+
+static void test_bernoulli(void) {
+  static uint8_t dst[TEST_SIZE];
+  alea_sample_bernoulli_u8_array(g_state_128, dst, TEST_SIZE, 3, 3);
+  check_bernoulli_count(dst, TEST_SIZE, 3.0 / 8);
+  alea_sample_bernoulli_u8_array(g_state_256, dst, TEST_SIZE, 1, 10);
+  check_bernoulli_count(dst, TEST_SIZE, 1.0 / 1024);
+  alea_sample_bernoulli_u8_array(g_state_128, dst, TEST_SIZE,
+                                 UINT64_C(0xc000000000000000), 64);
+  check_bernoulli_count(dst, TEST_SIZE, 0.75);
+  alea_sample_bernoulli_u8_array(g_state_256, dst, TEST_SIZE, 0, 16);
+  check_bernoulli_count(dst, TEST_SIZE, 0);
+
+  // The packed form holds the same bits as the u8 form of one stream, and the
+  // unused bits of the last byte are zero.
+  const size_t len = TEST_SIZE - 3;
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE256] = {0};
+  static uint8_t packed[(TEST_SIZE + 7) / 8];
+  alea_state *a = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+  alea_state *b = alea_init(seed, ALEA_ALGORITHM_SHAKE256);
+  memset(packed, 0xff, sizeof(packed));
+  alea_sample_bernoulli_u8_array(a, dst, len, 5, 4);
+  alea_sample_bernoulli_bits_array(b, packed, len, 5, 4);
+  for (size_t i = 0; i < len; ++i) {
+    TEST_ASSERT_EQUAL(dst[i], (packed[i / 8] >> (i % 8)) & 1);
+  }
+  TEST_ASSERT_EQUAL(0, packed[(len - 1) / 8] >> (len % 8));
+  alea_free(a);
+  alea_free(b);
+}
+
+static void test_floating_point(void) {
+  // Uniform in [0, 1): mean 1/2 and variance 1/12, on the 2^-53 grid.
+  static double dst[TEST_SIZE];
+  alea_get_random_double_array(g_state_128, dst, TEST_SIZE);
+  double mean = 0, var = 0;
+  int odd = 0;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    TEST_ASSERT_EQUAL(1, (dst[i] >= 0 && dst[i] < 1));
+    const double scaled = ldexp(dst[i], 53);
+    TEST_ASSERT_EQUAL(1, (scaled == floor(scaled)));
+    odd |= fmod(scaled, 2) == 1;
+    mean += dst[i];
+    var += (dst[i] - 0.5) * (dst[i] - 0.5);
+  }
+  TEST_ASSERT_EQUAL(1, odd);
+  TEST_ASSERT_EQUAL(
+      1, (fabs(mean / TEST_SIZE - 0.5) <= 5 * sqrt(1.0 / 12 / TEST_SIZE)));
+  TEST_ASSERT_EQUAL(1, (fabs(var / TEST_SIZE - 1.0 / 12) <= 0.01));
+
+  static float dstf[TEST_SIZE];
+  alea_get_random_float_array(g_state_256, dstf, TEST_SIZE);
+  mean = 0;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    TEST_ASSERT_EQUAL(1, (dstf[i] >= 0 && dstf[i] < 1));
+    mean += dstf[i];
+  }
+  TEST_ASSERT_EQUAL(
+      1, (fabs(mean / TEST_SIZE - 0.5) <= 5 * sqrt(1.0 / 12 / TEST_SIZE)));
+
+  // Continuous Gaussian: standard deviation within the usual tolerance, and
+  // samples are not rounded.
+  alea_sample_gaussian_double_array(g_state_128, dst, TEST_SIZE, TEST_STD);
+  mean = 0;
+  var = 0;
+  size_t integral = 0;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    mean += dst[i];
+    integral += dst[i] == floor(dst[i]);
+  }
+  mean /= TEST_SIZE;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    var += (dst[i] - mean) * (dst[i] - mean);
+  }
+  const double stdev = sqrt(var / TEST_SIZE);
+  TEST_ASSERT_EQUAL(1, (TEST_STD * (1 + VERIFY_SIGMA_TOLER) >= stdev));
+  TEST_ASSERT_EQUAL(1, (TEST_STD * (1 - VERIFY_SIGMA_TOLER) <= stdev));
+  TEST_ASSERT_LESS_THAN(10, integral);
+}
+
+#define TEST_BIGINT_LEN 30000
+
+// Checks that values in [0, num_bins) are spread evenly over the bins.
+static void check_uniform_counts(const size_t *count, const size_t num_bins,
+                                 const size_t len) {
+  const double expected = (double)len / (double)num_bins;
+  const double sigma = sqrt(expected * (1 - 1.0 / (double)num_bins));
+  for (size_t v = 0; v < num_bins; ++v) {
+    TEST_ASSERT_EQUAL(1, (5.0 * sigma >= fabs((double)count[v] - expected)));
+  }
+}
+
+static void test_uniform_mod_bigint(void) {
+  // M = 3 * 2^128 + 7: the top limb is uniform over {0, 1, 2} up to a 2^-128
+  // bias, and a top limb of 3 is accepted only with small lower limbs.
+  const uint64_t m[3] = {7, 0, 3};
+  static uint64_t dst[3 * TEST_BIGINT_LEN];
+  size_t count[4] = {0, 0, 0, 0};
+  alea_sample_uniform_mod_bigint_array(g_state_128, dst, TEST_BIGINT_LEN, m,
+                                       3);
+  for (size_t i = 0; i < TEST_BIGINT_LEN; ++i) {
+    const uint64_t *x = dst + 3 * i;
+    TEST_ASSERT_EQUAL(1, (x[2] < 3 || (x[2] == 3 && x[1] == 0 && x[0] < 7)));
+    count[x[2]]++;
+  }
+  check_uniform_counts(count, 3, TEST_BIGINT_LEN);
+
+  const uint64_t ten = 10;
+  size_t digits[10];
+  memset(digits, 0, sizeof(digits));
+  for (size_t i = 0; i < TEST_BIGINT_LEN; ++i) {
+    uint64_t x;
+    alea_sample_uniform_mod_bigint(g_state_256, &x, &ten, 1);
+    TEST_ASSERT_LESS_THAN(10, x);
+    digits[x]++;
+  }
+  check_uniform_counts(digits, 10, TEST_BIGINT_LEN);
+
+  const uint64_t moduli[3] = {3, 65537, UINT64_C(0xffffffffffffffc5)};
+  memset(count, 0, sizeof(count));
+  alea_sample_uniform_rns(g_state_128, dst, TEST_BIGINT_LEN, moduli, 3);
+  for (size_t l = 0; l < 3; ++l) {
+    for (size_t i = 0; i < TEST_BIGINT_LEN; ++i) {
+      TEST_ASSERT_EQUAL(1, (dst[l * TEST_BIGINT_LEN + i] < moduli[l]));
+    }
+  }
+  for (size_t i = 0; i < TEST_BIGINT_LEN; ++i) {
+    count[dst[i]]++;
+  }
+  check_uniform_counts(count, 3, TEST_BIGINT_LEN);
+}
+
+#define TEST_SHUFFLE_LEN 6
+#define TEST_SHUFFLE_RUNS 12000
+
+// Shuffles 0, ..., TEST_SHUFFLE_LEN - 1 many times and checks that every
+// element lands in every position equally often.
+static void check_shuffle_positions(alea_return (*shuffle)(alea_state *,
+                                                           uint32_t *const,
+                                                           const size_t)) {
+  int count[TEST_SHUFFLE_LEN][TEST_SHUFFLE_LEN];
+  memset(count, 0, sizeof(count));
+  for (int r = 0; r < TEST_SHUFFLE_RUNS; ++r) {
+    uint32_t arr[TEST_SHUFFLE_LEN];
+    for (uint32_t i = 0; i < TEST_SHUFFLE_LEN; ++i) {
+      arr[i] = i;
+    }
+    shuffle(g_state_128, arr, TEST_SHUFFLE_LEN);
+    for (size_t i = 0; i < TEST_SHUFFLE_LEN; ++i) {
+      count[arr[i]][i]++;
+    }
+  }
+
+  const double expected = (double)TEST_SHUFFLE_RUNS / TEST_SHUFFLE_LEN;
+  const double sigma = sqrt(expected * (1 - 1.0 / TEST_SHUFFLE_LEN));
+  for (size_t v = 0; v < TEST_SHUFFLE_LEN; ++v) {
+    for (size_t i = 0; i < TEST_SHUFFLE_LEN; ++i) {
+      TEST_ASSERT_EQUAL(1, (5.0 * sigma >= fabs(count[v][i] - expected)));
+    }
+  }
+}
+
+static void test_shuffle(void) {
+  check_shuffle_positions(alea_shuffle_u32);
+  check_shuffle_positions(alea_shuffle_u32_ct);
+
+  static uint32_t perm[TEST_SIZE];
+  static uint8_t seen[TEST_SIZE];
+  for (int ct = 0; ct < 2; ++ct) {
+    if (ct) {
+      alea_random_permutation_ct(g_state_256, perm, TEST_SIZE);
+    } else {
+      alea_random_permutation(g_state_256, perm, TEST_SIZE);
+    }
+    memset(seen, 0, sizeof(seen));
+    size_t fixed = 0;
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+      TEST_ASSERT_LESS_THAN(TEST_SIZE, perm[i]);
+      TEST_ASSERT_EQUAL(0, seen[perm[i]]);
+      seen[perm[i]] = 1;
+      fixed += perm[i] == i;
+    }
+    TEST_ASSERT_LESS_THAN(10, fixed); // one fixed point expected
+  }
+
+  // 64-bit entries come through unchanged, only reordered.
+  static uint64_t arr[TEST_SIZE];
+  uint64_t sum = 0, xor = 0;
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    arr[i] = alea_get_random_uint64(g_state_128);
+    sum += arr[i];
+    xor ^= arr[i] * 3;
+  }
+  alea_shuffle_u64(g_state_128, arr, TEST_SIZE);
+  alea_shuffle_u64_ct(g_state_256, arr, TEST_SIZE);
+  for (size_t i = 0; i < TEST_SIZE; ++i) {
+    sum -= arr[i];
+    xor ^= arr[i] * 3;
+  }
+  TEST_ASSERT_EQUAL(0, sum);
+  TEST_ASSERT_EQUAL(0, xor);
+}
+
 int main() {
   UNITY_BEGIN();
 #define X(NAME, API, TYPE, SIZE, OPT) RUN_TEST(test_##NAME);
   FUNCTIONALITY_TEST_LIST
 #undef X
+  RUN_TEST(test_range_sampler);
+  RUN_TEST(test_hwt_workspace);
+  RUN_TEST(test_hwt_large);
+  RUN_TEST(test_hwt_sparse);
+  RUN_TEST(test_hwt_short);
+  RUN_TEST(test_discrete_gaussian);
+  RUN_TEST(test_discrete_gaussian_center);
+  RUN_TEST(test_ternary);
+  RUN_TEST(test_bernoulli);
+  RUN_TEST(test_xor_random_bytes);
+  RUN_TEST(test_peek_consume);
+  RUN_TEST(test_uniform_mod_bigint);
+  RUN_TEST(test_floating_point);
+  RUN_TEST(test_shuffle);
 
   return UNITY_END();
 }
@@ -16,9 +16,12 @@
 
 #include "alea/alea.h"
 #include "alea/algorithms.h"
+#include "alea/dgauss_test_s100_p6.h"
+#include "alea/dgauss_test_s3_2.h"
 
 #include <unity.h>
 
+#include <math.h>
 #include <string.h>
 
 alea_state *g_state_128;
@@ -196,6 +199,352 @@ static void hkdf_sha3_256(void) {
   TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, okm, 42);
 }
 
+#define BITS_TEST_WORDS 64
+
+// Bits are handed out LSB first from consecutive stream words, across calls,
+// and a reseed drops whatever is left in the reservoir.
+static void random_bits_layout(void) {
+  uint64_t words[BITS_TEST_WORDS];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x36};
+
+  alea_reseed(g_state_128, seed);
+  alea_get_random_uint64_array(g_state_128, words, BITS_TEST_WORDS);
+
+  alea_reseed(g_state_128, seed);
+  size_t pos = 0;
+  for (unsigned nbits = 1; pos + nbits <= 64 * BITS_TEST_WORDS;
+       nbits = nbits % 64 + 1) {
+    uint64_t expected = 0;
+    for (unsigned b = 0; b < nbits; ++b, ++pos) {
+      expected |= ((words[pos / 64] >> (pos % 64)) & 1) << b;
+    }
+    TEST_ASSERT_EQUAL(expected, alea_get_random_bits(g_state_128, nbits));
+  }
+
+  alea_reseed(g_state_128, seed);
+  alea_get_random_bits(g_state_128, 3);
+  alea_reseed(g_state_128, seed);
+  TEST_ASSERT_EQUAL(words[0], alea_get_random_bits(g_state_128, 64));
+}
+
+#define CBD_TEST_LEN 1003 // not a multiple of any kernel's per-word count
+#define CBD_TEST_MAX_FLIPS 300
+
+// Every CBD kernel consumes the stream the same way: coefficient i is the
+// popcount of stream bits [2 * eta * i, 2 * eta * i + eta) minus the popcount
+// of the next eta bits.
+static int64_t cbd_reference(const uint8_t *bits, size_t i, size_t eta) {
+  int64_t c = 0;
+  for (size_t b = 0; b < 2 * eta; ++b) {
+    const size_t pos = 2 * eta * i + b;
+    const int bit = (bits[pos / 8] >> (pos % 8)) & 1;
+    c += b < eta ? bit : -bit;
+  }
+  return c;
+}
+
+static void cbd_stream_layout(void) {
+  static uint8_t bits[2 * CBD_TEST_MAX_FLIPS * CBD_TEST_LEN / 8];
+  static int64_t out64[CBD_TEST_LEN];
+  static int32_t out32[CBD_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x42};
+  const size_t etas[] = {
+      1, 2, 3, 5, 21, 32, 33, 64, 65, 128, CBD_TEST_MAX_FLIPS,
+  };
+
+  for (size_t e = 0; e < sizeof(etas) / sizeof(etas[0]); ++e) {
+    const size_t eta = etas[e];
+    alea_reseed(g_state_128, seed);
+    alea_get_random_bytes(g_state_128, bits, sizeof(bits));
+    alea_reseed(g_state_128, seed);
+    alea_sample_cbd_int64_array(g_state_128, out64, CBD_TEST_LEN, eta);
+    alea_reseed(g_state_128, seed);
+    alea_sample_cbd_int32_array(g_state_128, out32, CBD_TEST_LEN, eta);
+
+    for (size_t i = 0; i < CBD_TEST_LEN; ++i) {
+      TEST_ASSERT_EQUAL(cbd_reference(bits, i, eta), out64[i]);
+      TEST_ASSERT_EQUAL(out64[i], out32[i]);
+    }
+  }
+}
+
+#define GAUSSIAN_TEST_LEN 20000
+
+// The libm formulation of the Box-Muller transform that the library's
+// polynomial kernel approximates.
+static void gaussian_reference(const uint64_t *rnd, int64_t *dst, size_t len,
+                               double stdev) {
+  for (size_t i = 0; i < len; i += 2) {
+    const uint64_t rn1 = rnd[i / 2] >> 32;
+    const uint64_t rn2 = rnd[i / 2] & UINT64_C(0xFFFFFFFF);
+    const double r1 = (double)rn1 / 4294967296.;
+    const double r2 = ((double)rn2 + 1.0) / 4294967296.;
+    const double theta = r1 * 6.28318530717958647692;
+    const double rr = sqrt(-2.0 * log(r2)) * stdev;
+
+    dst[i] = llround(rr * cos(theta));
+    dst[i + 1] = llround(rr * sin(theta));
+  }
+}
+
+static void gaussian_matches_reference(void) {
+  static uint64_t rnd[GAUSSIAN_TEST_LEN / 2];
+  static int64_t expected[GAUSSIAN_TEST_LEN];
+  static int64_t out64[GAUSSIAN_TEST_LEN];
+  static int32_t out32[GAUSSIAN_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x17};
+  const double stdevs[] = {3.2, 1000.0, 1048576.0};
+
+  for (size_t k = 0; k < sizeof(stdevs) / sizeof(stdevs[0]); ++k) {
+    alea_reseed(g_state_128, seed);
+    alea_get_random_uint64_array(g_state_128, rnd, GAUSSIAN_TEST_LEN / 2);
+    gaussian_reference(rnd, expected, GAUSSIAN_TEST_LEN, stdevs[k]);
+
+    alea_reseed(g_state_128, seed);
+    alea_sample_gaussian_int64_array(g_state_128, out64, GAUSSIAN_TEST_LEN,
+                                     stdevs[k]);
+    alea_reseed(g_state_128, seed);
+    alea_sample_gaussian_int32_array(g_state_128, out32, GAUSSIAN_TEST_LEN,
+                                     stdevs[k]);
+
+    for (size_t i = 0; i < GAUSSIAN_TEST_LEN; ++i) {
+      TEST_ASSERT_EQUAL(expected[i], out64[i]);
+      TEST_ASSERT_EQUAL(expected[i], out32[i]);
+    }
+  }
+}
+
+// The continuous samples follow the libm formulation to within rounding.
+static void gaussian_double_matches_reference(void) {
+  static uint64_t rnd[GAUSSIAN_TEST_LEN];
+  static double out[GAUSSIAN_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x18};
+  const double stdevs[] = {3.2, 1048576.0};
+
+  for (size_t k = 0; k < sizeof(stdevs) / sizeof(stdevs[0]); ++k) {
+    alea_reseed(g_state_128, seed);
+    alea_get_random_uint64_array(g_state_128, rnd, GAUSSIAN_TEST_LEN);
+    alea_reseed(g_state_128, seed);
+    alea_sample_gaussian_double_array(g_state_128, out, GAUSSIAN_TEST_LEN,
+                                      stdevs[k]);
+
+    for (size_t i = 0; i < GAUSSIAN_TEST_LEN; i += 2) {
+      const double theta = ldexp((double)rnd[i], -64) * 6.28318530717958647692;
+      const double u = ldexp((double)((rnd[i + 1] >> 11) + 1), -53);
+      const double rr = sqrt(-2.0 * log(u)) * stdevs[k];
+      const double tol = 1e-12 * stdevs[k];
+      TEST_ASSERT_EQUAL(1, (fabs(out[i] - rr * cos(theta)) <= tol));
+      TEST_ASSERT_EQUAL(1, (fabs(out[i + 1] - rr * sin(theta)) <= tol));
+    }
+  }
+}
+
+#define DGAUSS_TEST_LEN 1000 // not a multiple of the 64-sample batch
+#define DGAUSS_MAX_TABLE_LEN 600
+
+// Looks each sample up in the CDT for D_{Z, sigma} cut at table_len, with
+// entries rounded to `precision` bits and saturated at 2^precision - 1. It uses
+// the bit-plane layout of the generated sampler: `precision` words of uniform
+// bits and one word of signs per batch of 64.
+static void dgauss_reference(const uint64_t *rnd, int64_t *dst, size_t len,
+                             const double sigma, const size_t table_len,
+                             const unsigned precision) {
+  uint64_t cdt[DGAUSS_MAX_TABLE_LEN];
+  double total = 1.0;
+  for (size_t k = table_len; k > 0; k--) {
+    total += 2.0 * exp(-(double)(k * k) / (2.0 * sigma * sigma));
+  }
+  const double limit = ldexp(1.0, (int)precision);
+  double tail = 0;
+  for (size_t k = table_len; k > 0; k--) {
+    tail += 2.0 * exp(-(double)(k * k) / (2.0 * sigma * sigma));
+    const double scaled = ldexp(tail / total, (int)precision) + 0.5;
+    cdt[k - 1] = scaled >= limit ? (uint64_t)(limit - 1) : (uint64_t)scaled;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    const uint64_t *r = rnd + (i / 64) * (precision + 1);
+    uint64_t u = 0;
+    for (unsigned b = 0; b < precision; b++) {
+      u |= ((r[b] >> (i % 64)) & 1) << b;
+    }
+    int64_t mag = 0;
+    for (size_t k = 0; k < table_len; k++) {
+      mag += u < cdt[k];
+    }
+    dst[i] = ((r[precision] >> (i % 64)) & 1) ? -mag : mag;
+  }
+}
+
+static void dgauss_matches_cdt(void) {
+  static uint64_t rnd[(DGAUSS_TEST_LEN + 63) / 64 * 65];
+  static int64_t expected[DGAUSS_TEST_LEN];
+  static int64_t out64[DGAUSS_TEST_LEN];
+  static int32_t out32[DGAUSS_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x33};
+
+  // sigma = 3.2 at the generator's defaults, tail cut 12 and 64-bit precision
+  alea_reseed(g_state_128, seed);
+  alea_get_random_uint64_array(g_state_128, rnd, sizeof(rnd) / sizeof(rnd[0]));
+  dgauss_reference(rnd, expected, DGAUSS_TEST_LEN, 3.2, 39, 64);
+
+  alea_reseed(g_state_128, seed);
+  alea_sample_dgauss_test_s3_2_int64_array(g_state_128, out64, DGAUSS_TEST_LEN);
+  alea_reseed(g_state_128, seed);
+  alea_sample_dgauss_test_s3_2_int32_array(g_state_128, out32, DGAUSS_TEST_LEN);
+
+  for (size_t i = 0; i < DGAUSS_TEST_LEN; ++i) {
+    TEST_ASSERT_EQUAL(expected[i], out64[i]);
+    TEST_ASSERT_EQUAL(expected[i], out32[i]);
+  }
+
+  // sigma = 100 at tail cut 6 and 6-bit precision, where P(|x| >= 1) rounds
+  // up to 1 and the first entry saturates
+  alea_reseed(g_state_128, seed);
+  alea_get_random_uint64_array(g_state_128, rnd,
+                               (DGAUSS_TEST_LEN + 63) / 64 * 7);
+  dgauss_reference(rnd, expected, DGAUSS_TEST_LEN, 100, 600, 6);
+
+  alea_reseed(g_state_128, seed);
+  alea_sample_dgauss_test_s100_p6_int64_array(g_state_128, out64,
+                                              DGAUSS_TEST_LEN);
+  for (size_t i = 0; i < DGAUSS_TEST_LEN; ++i) {
+    TEST_ASSERT_EQUAL(expected[i], out64[i]);
+  }
+}
+
+#define DGAUSS_ZERO_RUNS 64000
+
+// With the first entry saturated at 2^6 - 1, exactly the all-ones draw gives
+// 0, so the generated sampler and the table sampler both hit 0 with
+// probability 1/64.
+static void dgauss_saturation_matches_table(void) {
+  static int64_t out[DGAUSS_ZERO_RUNS];
+  alea_gaussian_table *table = alea_gaussian_table_create(100, 6, 6);
+  TEST_ASSERT_NOT_NULL(table);
+
+  const double expected = DGAUSS_ZERO_RUNS / 64.0;
+  const double sigma = sqrt(expected * (1 - 1 / 64.0));
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 0) {
+      alea_sample_dgauss_test_s100_p6_int64_array(g_state_128, out,
+                                                  DGAUSS_ZERO_RUNS);
+    } else {
+      alea_sample_discrete_gaussian_int64_array(g_state_128, table, out,
+                                                DGAUSS_ZERO_RUNS);
+    }
+    size_t zeros = 0;
+    for (size_t i = 0; i < DGAUSS_ZERO_RUNS; ++i) {
+      zeros += out[i] == 0;
+    }
+    TEST_ASSERT_EQUAL(1, (5.0 * sigma >= fabs((double)zeros - expected)));
+  }
+  alea_gaussian_table_free(table);
+}
+
+#define RNS_TEST_LEN 1002
+#define RNS_TEST_LIMBS 4
+
+static const uint64_t rns_moduli[RNS_TEST_LIMBS] = {
+    3, 65537, UINT64_C(0x3fffffffffffffc7), UINT64_C(0x7fffffffffffffe7)};
+
+// Checks dst against x mod q for standard residues, and against
+// x * 2^64 mod q, computed by 64 doublings, for Montgomery residues.
+static void check_rns(const int64_t *x, const uint64_t *dst,
+                      const alea_repr repr) {
+  for (size_t l = 0; l < RNS_TEST_LIMBS; ++l) {
+    const uint64_t q = rns_moduli[l];
+    for (size_t i = 0; i < RNS_TEST_LEN; ++i) {
+      const int64_t r = x[i] % (int64_t)q;
+      uint64_t expected = r < 0 ? (uint64_t)(r + (int64_t)q) : (uint64_t)r;
+      if (repr == ALEA_REPR_MONTGOMERY) {
+        for (int b = 0; b < 64; b++) {
+          expected = expected * 2 >= q ? expected * 2 - q : expected * 2;
+        }
+      }
+      TEST_ASSERT_EQUAL(expected, dst[l * RNS_TEST_LEN + i]);
+    }
+  }
+}
+
+static void rns_matches_int64(void) {
+  static int64_t x[RNS_TEST_LEN];
+  static uint64_t dst[RNS_TEST_LIMBS * RNS_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x41};
+  const alea_repr reprs[] = {ALEA_REPR_STANDARD, ALEA_REPR_MONTGOMERY};
+
+  for (size_t k = 0; k < 2; ++k) {
+    alea_reseed(g_state_128, seed);
+    alea_sample_cbd_int64_array(g_state_128, x, RNS_TEST_LEN, 21);
+    alea_reseed(g_state_128, seed);
+    alea_sample_cbd_rns(g_state_128, dst, RNS_TEST_LEN, 21, rns_moduli,
+                        RNS_TEST_LIMBS, reprs[k]);
+    check_rns(x, dst, reprs[k]);
+
+    // large enough to wrap around the small moduli
+    alea_reseed(g_state_128, seed);
+    alea_sample_gaussian_int64_array(g_state_128, x, RNS_TEST_LEN, 0x1p40);
+    alea_reseed(g_state_128, seed);
+    alea_sample_gaussian_rns(g_state_128, dst, RNS_TEST_LEN, 0x1p40,
+                             rns_moduli, RNS_TEST_LIMBS, reprs[k]);
+    check_rns(x, dst, reprs[k]);
+
+    alea_reseed(g_state_128, seed);
+    alea_sample_hwt_int64_array(g_state_128, x, RNS_TEST_LEN, 64);
+    alea_reseed(g_state_128, seed);
+    alea_sample_hwt_rns(g_state_128, dst, RNS_TEST_LEN, 64, rns_moduli,
+                        RNS_TEST_LIMBS, reprs[k]);
+    check_rns(x, dst, reprs[k]);
+
+    alea_reseed(g_state_128, seed);
+    alea_sample_ternary_int64_array(g_state_128, x, RNS_TEST_LEN, 0.5);
+    alea_reseed(g_state_128, seed);
+    alea_sample_ternary_rns(g_state_128, dst, RNS_TEST_LEN, 0.5, rns_moduli,
+                            RNS_TEST_LIMBS, reprs[k]);
+    check_rns(x, dst, reprs[k]);
+  }
+}
+
+// The fused additions match sampling into an int64 array and adding it.
+static void add_mod_q_matches_int64(void) {
+  static int64_t x[RNS_TEST_LEN];
+  static uint64_t base[RNS_TEST_LEN], dst[RNS_TEST_LEN];
+  const uint8_t seed[ALEA_SEED_SIZE_SHAKE128] = {0x42};
+
+  for (size_t l = 0; l < RNS_TEST_LIMBS; ++l) {
+    const uint64_t q = rns_moduli[l];
+    for (size_t i = 0; i < RNS_TEST_LEN; ++i) {
+      base[i] = alea_get_random_uint64(g_state_128) % q;
+    }
+
+    for (int kind = 0; kind < 3; ++kind) {
+      memcpy(dst, base, sizeof(dst));
+      alea_reseed(g_state_128, seed);
+      if (kind == 0) {
+        alea_sample_cbd_int64_array(g_state_128, x, RNS_TEST_LEN, 21);
+        alea_reseed(g_state_128, seed);
+        alea_add_cbd_mod_q(g_state_128, dst, RNS_TEST_LEN, 21, q);
+      } else if (kind == 1) {
+        alea_sample_gaussian_int64_array(g_state_128, x, RNS_TEST_LEN, 0x1p40);
+        alea_reseed(g_state_128, seed);
+        alea_add_gaussian_mod_q(g_state_128, dst, RNS_TEST_LEN, 0x1p40, q);
+      } else {
+        alea_sample_ternary_int64_array(g_state_128, x, RNS_TEST_LEN, 0.5);
+        alea_reseed(g_state_128, seed);
+        alea_add_ternary_mod_q(g_state_128, dst, RNS_TEST_LEN, 0.5, q);
+      }
+
+      for (size_t i = 0; i < RNS_TEST_LEN; ++i) {
+        const int64_t r = x[i] % (int64_t)q;
+        const uint64_t e = r < 0 ? (uint64_t)(r + (int64_t)q) : (uint64_t)r;
+        const uint64_t expected = base[i] >= q - e ? base[i] - (q - e)
+                                                   : base[i] + e;
+        TEST_ASSERT_EQUAL(expected, dst[i]);
+      }
+    }
+  }
+}
+
 int main() {
   UNITY_BEGIN();
   RUN_TEST(state_init_and_free);
@@ -204,5 +553,13 @@ int main() {
   RUN_TEST(resqueezing_shake128);
   RUN_TEST(resqueezing_shake256);
   RUN_TEST(hkdf_sha3_256);
+  RUN_TEST(random_bits_layout);
+  RUN_TEST(cbd_stream_layout);
+  RUN_TEST(gaussian_matches_reference);
+  RUN_TEST(gaussian_double_matches_reference);
+  RUN_TEST(dgauss_matches_cdt);
+  RUN_TEST(dgauss_saturation_matches_table);
+  RUN_TEST(rns_matches_int64);
+  RUN_TEST(add_mod_q_matches_int64);
   return UNITY_END();
 }